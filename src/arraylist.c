@@ -3,6 +3,8 @@
 */
 
 #include "arraylist.h"
+#include "bitset.h"
+#include "trace.h"
 #include <asm-generic/errno.h>
 
 typedef _choco_arraylist_header _header;
@@ -21,6 +23,180 @@ typedef _choco_arraylist_allocator _allocator;
 #define _get_header(arrlist) \
     (((_header*)arrlist) - 1)
 
+#define _is_shared(header) \
+    (__atomic_load_n(&(header)->refs, __ATOMIC_ACQUIRE) > 1)
+
+// Drops one reference to the buffer. Returns 1 when the caller held the last one and has to
+// free it. A count of 0 is treated as 1 so that headers built by hand stay usable.
+static int _drop_reference(_header* header)
+{
+    if (!_is_shared(header)) {
+        return 1;
+    }
+
+    return __atomic_sub_fetch(&header->refs, 1, __ATOMIC_ACQ_REL) == 0;
+}
+
+// Gives `*arrlist` a buffer of its own before a write, copying it when a snapshot still shares
+// it. Returns 0 when the copy could not be made.
+static int _make_writable(_choco_arraylist* arrlist)
+{
+    *arrlist = _choco_arraylist_unshare(*arrlist);
+    return !_is_shared(_get_header(*arrlist));
+}
+
+#define _clear_pending(pending, index) \
+    ((pending)[(index) / 64] &= ~(UINT64_C(1) << ((index) % 64)))
+
+#define _is_pending(pending, index) \
+    (((pending)[(index) / 64] >> ((index) % 64)) & 1)
+
+// Reordering kernels. Elements of 1 to 32 bytes get loops where every copy has a length known
+// at compile time, so they become plain moves; other sizes go through `memcpy`, in blocks of
+// 64 bytes when swapping.
+#define _define_kernels(bytes)                                                                  \
+    static void _swap_##bytes(char* a, char* b, size_t size)                                    \
+    {                                                                                           \
+        char temp[bytes];                                                                       \
+        memcpy(temp, a, bytes);                                                                 \
+        memcpy(a, b, bytes);                                                                    \
+        memcpy(b, temp, bytes);                                                                 \
+    }                                                                                           \
+                                                                                                \
+    static void _reverse_##bytes(char* data, size_t count, size_t size)                         \
+    {                                                                                           \
+        char* low = data;                                                                       \
+        char* high = data + (count - 1) * bytes;                                                \
+        for (; low < high; low += bytes, high -= bytes) {                                       \
+            _swap_##bytes(low, high, bytes);                                                    \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    static void _gather_##bytes(char* dst, const char* src, const size_t* indices, size_t count, size_t size) \
+    {                                                                                           \
+        for (size_t i = 0; i < count; i++) {                                                    \
+            memcpy(dst + i * bytes, src + indices[i] * bytes, bytes);                           \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    static void _scatter_##bytes(char* dst, const char* src, const size_t* indices, size_t count, size_t size) \
+    {                                                                                           \
+        for (size_t i = 0; i < count; i++) {                                                    \
+            memcpy(dst + indices[i] * bytes, src + i * bytes, bytes);                           \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    static void _cycle_##bytes(char* data, const size_t* indices, size_t start, _choco_bitset pending, size_t size) \
+    {                                                                                           \
+        char temp[bytes];                                                                       \
+        size_t current = start;                                                                 \
+        memcpy(temp, data + start * bytes, bytes);                                              \
+        while (indices[current] != start) {                                                     \
+            memcpy(data + current * bytes, data + indices[current] * bytes, bytes);             \
+            _clear_pending(pending, current);                                             \
+            current = indices[current];                                                         \
+        }                                                                                       \
+        memcpy(data + current * bytes, temp, bytes);                                            \
+        _clear_pending(pending, current);                                                 \
+    }                                                                                           \
+                                                                                                \
+    static const _kernels _kernels_##bytes = {                                                  \
+        .swap = _swap_##bytes,                                                                  \
+        .reverse = _reverse_##bytes,                                                            \
+        .gather = _gather_##bytes,                                                              \
+        .scatter = _scatter_##bytes,                                                            \
+        .cycle = _cycle_##bytes,                                                                \
+    };
+
+typedef struct _kernels {
+    void (*swap)(char* a, char* b, size_t size);
+    void (*reverse)(char* data, size_t count, size_t size);
+    void (*gather)(char* dst, const char* src, const size_t* indices, size_t count, size_t size);
+    void (*scatter)(char* dst, const char* src, const size_t* indices, size_t count, size_t size);
+    void (*cycle)(char* data, const size_t* indices, size_t start, _choco_bitset pending, size_t size);
+} _kernels;
+
+_define_kernels(1)
+_define_kernels(2)
+_define_kernels(4)
+_define_kernels(8)
+_define_kernels(16)
+_define_kernels(32)
+
+static void _swap_blocked(char* a, char* b, size_t size)
+{
+    char block[64];
+    for (size_t offset = 0; offset < size; offset += sizeof(block)) {
+        size_t chunk = size - offset < sizeof(block) ? size - offset : sizeof(block);
+        memcpy(block, a + offset, chunk);
+        memcpy(a + offset, b + offset, chunk);
+        memcpy(b + offset, block, chunk);
+    }
+}
+
+static void _reverse_blocked(char* data, size_t count, size_t size)
+{
+    char* low = data;
+    char* high = data + (count - 1) * size;
+    for (; low < high; low += size, high -= size) {
+        _swap_blocked(low, high, size);
+    }
+}
+
+static void _gather_blocked(char* dst, const char* src, const size_t* indices, size_t count, size_t size)
+{
+    for (size_t i = 0; i < count; i++) {
+        memcpy(dst + i * size, src + indices[i] * size, size);
+    }
+}
+
+static void _scatter_blocked(char* dst, const char* src, const size_t* indices, size_t count, size_t size)
+{
+    for (size_t i = 0; i < count; i++) {
+        memcpy(dst + indices[i] * size, src + i * size, size);
+    }
+}
+
+// Large elements are rotated along the cycle with swaps, which needs no element sized buffer.
+static void _cycle_blocked(char* data, const size_t* indices, size_t start, _choco_bitset pending, size_t size)
+{
+    size_t current = start;
+    while (indices[current] != start) {
+        _swap_blocked(data + current * size, data + indices[current] * size, size);
+        _clear_pending(pending, current);
+        current = indices[current];
+    }
+    _clear_pending(pending, current);
+}
+
+static const _kernels _kernels_blocked = {
+    .swap = _swap_blocked,
+    .reverse = _reverse_blocked,
+    .gather = _gather_blocked,
+    .scatter = _scatter_blocked,
+    .cycle = _cycle_blocked,
+};
+
+static const _kernels* _kernels_for(size_t size)
+{
+    switch (size) {
+    case 1:
+        return &_kernels_1;
+    case 2:
+        return &_kernels_2;
+    case 4:
+        return &_kernels_4;
+    case 8:
+        return &_kernels_8;
+    case 16:
+        return &_kernels_16;
+    case 32:
+        return &_kernels_32;
+    default:
+        return &_kernels_blocked;
+    }
+}
+
 static void* _heap_alloc(void* self, size_t size)
 {
     return malloc(size);
@@ -35,7 +211,9 @@ _allocator _choco_arraylist_heap_allocator(void)
 {
     _allocator allocator = {
         .allocate = _heap_alloc,
-        .deallocate = _heap_dealloc
+        .deallocate = _heap_dealloc,
+        .reallocate = NULL,
+        .context = NULL,
     };
     return allocator;
 }
@@ -46,6 +224,7 @@ _choco_arraylist _choco_arraylist_create(_allocator allocator, size_t size, size
         return NULL;
     }
 
+    _choco_trace_start(create, start);
     size_t required_space = _physical_size(size, desired);
     _header* header = allocator.allocate(&allocator, required_space);
     if (header == NULL) {
@@ -57,9 +236,11 @@ _choco_arraylist _choco_arraylist_create(_allocator allocator, size_t size, size
         .allocator = allocator,
         .data = header + 1,
         .size = size,
-        .used = 0
+        .used = 0,
+        .refs = 1
     };
 
+    _choco_trace_create(header->data, size, desired, start);
     return header->data;
 }
 
@@ -114,9 +295,19 @@ _result _choco_arraylist_destroy(_choco_arraylist arrlist)
         return _CHOCO_ARRAYLIST_RESULT_ERROR;
     }
 
-    size_t size = _choco_arraylist_sizeof(arrlist);
-    memset(header, 0, size);
-    header->allocator.deallocate(&header->allocator, header);
+    if (!_drop_reference(header)) {
+        return _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    _choco_trace_start(destroy, start);
+    _allocator allocator = header->allocator;
+    size_t element_size = header->size;
+    size_t capacity = header->allocated;
+    // Only the header is cleared: touching every element would fault in pages that an unmapping
+    // allocator is about to release.
+    memset(header, 0, sizeof(_header));
+    allocator.deallocate(&allocator, header);
+    _choco_trace_destroy(arrlist, element_size, capacity, start);
     return _CHOCO_ARRAYLIST_RESULT_OK;
 }
 
@@ -135,37 +326,90 @@ void* _choco_arraylist_at(_choco_arraylist arrlist, size_t index)
     return _get_element(arrlist, header->size, index);
 }
 
-_choco_arraylist _choco_arraylist_resize(_choco_arraylist arrlist, size_t desired)
+void* _choco_arraylist_at_writable(_choco_arraylist* arrlist, size_t index)
 {
-    if (arrlist == NULL) {
+    if (arrlist == NULL || _choco_arraylist_at(*arrlist, index) == NULL || !_make_writable(arrlist)) {
         return NULL;
     }
 
+    return _get_element(*arrlist, _choco_arraylist_get_header(*arrlist)->size, index);
+}
+
+// Moves the list to a buffer of `desired` elements. Returns NULL, leaving the list untouched,
+// when the allocator fails. Tracing is left to the callers, so that growing is reported once.
+static _choco_arraylist _resize(_choco_arraylist arrlist, size_t desired)
+{
     _header* header = _choco_arraylist_get_header(arrlist);
     _allocator allocator = header->allocator;
-    int is_allocator_valid = _is_allocator_valid(allocator);
-    if (!is_allocator_valid) {
-        return arrlist;
+    size_t desired_size = _physical_size(header->size, desired);
+    size_t kept = header->used < desired ? header->used : desired;
+
+    if (allocator.reallocate != NULL && !_is_shared(header)) {
+        size_t current_size = _physical_size(header->size, header->allocated);
+        _header* moved = allocator.reallocate(&allocator, header, current_size, desired_size);
+        if (moved != NULL) {
+            moved->allocated = desired;
+            moved->used = kept;
+            moved->data = moved + 1;
+            return moved->data;
+        }
     }
 
-    size_t desired_size = _physical_size(header->size, desired);
     _header* new_header = allocator.allocate(&allocator, desired_size);
     if (new_header == NULL) {
-        return arrlist;
+        return NULL;
     }
 
     *new_header = (_header) {
         .allocated = desired,
         .allocator = allocator,
         .size = header->size,
-        .used = header->used,
+        .used = kept,
         .data = new_header + 1,
+        .refs = 1,
     };
 
+    memcpy(new_header->data, arrlist, header->size * kept);
+    if (_drop_reference(header)) {
+        allocator.deallocate(&allocator, header);
+    }
+    return new_header->data;
+}
+
+_choco_arraylist _choco_arraylist_resize(_choco_arraylist arrlist, size_t desired)
+{
+    if (arrlist == NULL) {
+        return NULL;
+    }
+
+    _header* header = _choco_arraylist_get_header(arrlist);
+    int is_allocator_valid = _is_allocator_valid(header->allocator);
+    if (!is_allocator_valid) {
+        return arrlist;
+    }
 
+    _choco_trace_start(resize, start);
+    size_t size = header->size;
+    size_t old_capacity = header->allocated;
+    _choco_arraylist resized = _resize(arrlist, desired);
+    if (resized == NULL) {
+        return arrlist;
+    }
 
-    allocator.deallocate(&allocator, header);
-    return new_header->data;
+    _choco_trace_resize(resized, size, old_capacity, desired, start);
+    return resized;
+}
+
+// Resizes for `_choco_arraylist_add` and `_choco_arraylist_add_n`, which report a grow event
+// of their own instead of the resize one.
+static _choco_arraylist _grow(_choco_arraylist arrlist, size_t desired)
+{
+    if (!_is_allocator_valid(_choco_arraylist_get_header(arrlist)->allocator)) {
+        return arrlist;
+    }
+
+    _choco_arraylist resized = _resize(arrlist, desired);
+    return resized != NULL ? resized : arrlist;
 }
 
 _choco_arraylist _choco_arraylist_add(_choco_arraylist arrlist)
@@ -178,49 +422,99 @@ _choco_arraylist _choco_arraylist_add(_choco_arraylist arrlist)
     _result is_full = _choco_arraylist_is_full(arrlist);
 
     if (is_full == _CHOCO_ARRAYLIST_RESULT_YES) {
-        arrlist = _choco_arraylist_resize(arrlist, (header->allocated + 1) * 2);
+        _choco_trace_start(grow, start);
+        size_t capacity = header->allocated;
+        arrlist = _grow(arrlist, (capacity + 1) * 2);
+        header = _choco_arraylist_get_header(arrlist);
+        if (header->allocated > capacity) {
+            _choco_trace_grow(arrlist, header->size, capacity, header->allocated, start);
+        }
+    } else if (_is_shared(header)) {
+        arrlist = _choco_arraylist_unshare(arrlist);
         header = _choco_arraylist_get_header(arrlist);
     }
 
+    if (header->used >= header->allocated || _is_shared(header)) {
+        return arrlist;
+    }
+
     void* element = _get_element(arrlist, header->size, header->used++);
     memset(element, 0, header->size);
     return arrlist;
 }
 
-_result _choco_arraylist_remove(_choco_arraylist arrlist)
+// Same as `_choco_arraylist_add` for `count` elements at once, growing the buffer at most once.
+_choco_arraylist _choco_arraylist_add_n(_choco_arraylist arrlist, size_t count)
 {
     if (arrlist == NULL) {
-        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        return NULL;
     }
 
     _header* header = _choco_arraylist_get_header(arrlist);
 
-    if (header->used == 0) {
+    if (header->used + count > header->allocated) {
+        _choco_trace_start(grow, start);
+        size_t capacity = header->allocated;
+        size_t desired = (capacity + 1) * 2;
+        if (desired < header->used + count) {
+            desired = header->used + count;
+        }
+        arrlist = _grow(arrlist, desired);
+        header = _choco_arraylist_get_header(arrlist);
+        if (header->allocated > capacity) {
+            _choco_trace_grow(arrlist, header->size, capacity, header->allocated, start);
+        }
+    } else if (_is_shared(header)) {
+        arrlist = _choco_arraylist_unshare(arrlist);
+        header = _choco_arraylist_get_header(arrlist);
+    }
+
+    if (header->used + count > header->allocated || _is_shared(header)) {
+        return arrlist;
+    }
+
+    void* elements = _get_element(arrlist, header->size, header->used);
+    memset(elements, 0, header->size * count);
+    header->used += count;
+    return arrlist;
+}
+
+_result _choco_arraylist_remove(_choco_arraylist* arrlist)
+{
+    if (arrlist == NULL || *arrlist == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    if (_choco_arraylist_get_header(*arrlist)->used == 0 || !_make_writable(arrlist)) {
         return _CHOCO_ARRAYLIST_RESULT_ERROR;
     }
 
+    _choco_trace_start(remove, start);
+    _header* header = _choco_arraylist_get_header(*arrlist);
     header->used--;
+    _choco_trace_remove(*arrlist, header->size, header->allocated, start);
     return _CHOCO_ARRAYLIST_RESULT_OK;
 }
 
-_result _choco_arraylist_swap(_choco_arraylist arrlist, size_t a, size_t b)
+_result _choco_arraylist_swap(_choco_arraylist* arrlist, size_t a, size_t b)
 {
-    if (arrlist == NULL) {
+    if (arrlist == NULL || *arrlist == NULL) {
         return _CHOCO_ARRAYLIST_RESULT_ERROR;
     }
 
-    _header* header = _choco_arraylist_get_header(arrlist);
+    _header* header = _choco_arraylist_get_header(*arrlist);
 
     if (a >= header->used || b >= header->used) {
         return _CHOCO_ARRAYLIST_RESULT_ERROR;
     }
 
-    char temp[header->size];
-    void* element_a = _get_element(arrlist, header->size, a);
-    void* element_b = _get_element(arrlist, header->size, b);
-    memcpy(temp, element_a, header->size);
-    memcpy(element_a, element_b, header->size);
-    memcpy(element_b, temp, header->size);
+    if (a != b) {
+        if (!_make_writable(arrlist)) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+        header = _choco_arraylist_get_header(*arrlist);
+        _kernels_for(header->size)->swap(_get_element(*arrlist, header->size, a), _get_element(*arrlist, header->size, b), header->size);
+    }
     return _CHOCO_ARRAYLIST_RESULT_OK;
 }
 
@@ -233,3 +527,238 @@ _result _choco_arraylist_is_full(_choco_arraylist arrlist)
     _header* header = _choco_arraylist_get_header(arrlist);
     return (header->used >= header->allocated) ? _CHOCO_ARRAYLIST_RESULT_YES : _CHOCO_ARRAYLIST_RESULT_NO;
 }
+
+_result _choco_arraylist_is_shared(_choco_arraylist arrlist)
+{
+    if (arrlist == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* header = _choco_arraylist_get_header(arrlist);
+    return _is_shared(header) ? _CHOCO_ARRAYLIST_RESULT_YES : _CHOCO_ARRAYLIST_RESULT_NO;
+}
+
+// The snapshot is the same buffer with one more reference. Every function that writes to the
+// list copies a shared buffer first and hands back the copy, so readers holding the snapshot
+// see the list as it was until they release it.
+_choco_arraylist _choco_arraylist_snapshot(_choco_arraylist arrlist)
+{
+    if (arrlist == NULL) {
+        return NULL;
+    }
+
+    // A single compare and swap, so that a count of 0, read as 1, cannot lose a reference to a
+    // concurrent snapshot.
+    _header* header = _choco_arraylist_get_header(arrlist);
+    size_t refs = __atomic_load_n(&header->refs, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&header->refs, &refs, (refs == 0 ? 1 : refs) + 1, 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+    }
+    return arrlist;
+}
+
+_result _choco_arraylist_release(_choco_arraylist snapshot)
+{
+    return _choco_arraylist_destroy(snapshot);
+}
+
+_choco_arraylist _choco_arraylist_unshare(_choco_arraylist arrlist)
+{
+    if (arrlist == NULL) {
+        return NULL;
+    }
+
+    _header* header = _choco_arraylist_get_header(arrlist);
+    if (!_is_shared(header)) {
+        return arrlist;
+    }
+
+    return _choco_arraylist_resize(arrlist, header->allocated);
+}
+
+_result _choco_arraylist_reverse(_choco_arraylist* arrlist)
+{
+    if (arrlist == NULL || *arrlist == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* header = _choco_arraylist_get_header(*arrlist);
+
+    if (header->used > 1) {
+        if (!_make_writable(arrlist)) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+        header = _choco_arraylist_get_header(*arrlist);
+        _kernels_for(header->size)->reverse(*arrlist, header->used, header->size);
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+// Rotates left with three reversals: every element is moved twice, sequentially.
+_result _choco_arraylist_rotate(_choco_arraylist* arrlist, size_t shift)
+{
+    if (arrlist == NULL || *arrlist == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* header = _choco_arraylist_get_header(*arrlist);
+
+    if (header->used < 2 || shift % header->used == 0) {
+        return _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    if (!_make_writable(arrlist)) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _choco_arraylist data = *arrlist;
+    header = _choco_arraylist_get_header(data);
+    const _kernels* kernels = _kernels_for(header->size);
+    shift %= header->used;
+    kernels->reverse(data, shift, header->size);
+    kernels->reverse(_get_element(data, header->size, shift), header->used - shift, header->size);
+    kernels->reverse(data, header->used, header->size);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+// Element `i` becomes the element previously at `indices[i]`. `indices` is checked to be a
+// permutation first, then each cycle is followed once; a bitset tracks the pending positions.
+_result _choco_arraylist_apply_permutation(_choco_arraylist* arrlist, const size_t* indices)
+{
+    if (arrlist == NULL || *arrlist == NULL || indices == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* header = _choco_arraylist_get_header(*arrlist);
+
+    // Temporary memory comes from the heap: the allocator of the list may not serve a bitset of
+    // that length, as with a pool whose blocks are smaller.
+    _choco_bitset pending = _choco_bitset_create(_choco_arraylist_heap_allocator(), header->used);
+    if (pending == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    for (size_t i = 0; i < header->used; i++) {
+        if (indices[i] >= header->used || _is_pending(pending, indices[i])) {
+            _choco_bitset_destroy(pending);
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+        pending[indices[i] / 64] |= UINT64_C(1) << (indices[i] % 64);
+    }
+
+    if (!_make_writable(arrlist)) {
+        _choco_bitset_destroy(pending);
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    header = _choco_arraylist_get_header(*arrlist);
+    const _kernels* kernels = _kernels_for(header->size);
+    size_t start = _choco_bitset_find_first_set(pending, 0);
+    while (start < header->used) {
+        kernels->cycle(*arrlist, indices, start, pending, header->size);
+        start = _choco_bitset_find_first_set(pending, start + 1);
+    }
+
+    _choco_bitset_destroy(pending);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_arraylist_gather(_choco_arraylist* dst, _choco_arraylist src, const size_t* indices, size_t count)
+{
+    if (dst == NULL || *dst == NULL || src == NULL || indices == NULL || *dst == src) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* dst_header = _choco_arraylist_get_header(*dst);
+    _header* src_header = _choco_arraylist_get_header(src);
+
+    if (dst_header->size != src_header->size || dst_header->used < count) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] >= src_header->used) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+    }
+
+    if (!_make_writable(dst)) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _kernels_for(src_header->size)->gather(*dst, src, indices, count, src_header->size);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_arraylist_scatter(_choco_arraylist* dst, _choco_arraylist src, const size_t* indices)
+{
+    if (dst == NULL || *dst == NULL || src == NULL || indices == NULL || *dst == src) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* dst_header = _choco_arraylist_get_header(*dst);
+    _header* src_header = _choco_arraylist_get_header(src);
+
+    if (dst_header->size != src_header->size) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    for (size_t i = 0; i < src_header->used; i++) {
+        if (indices[i] >= dst_header->used) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+    }
+
+    if (!_make_writable(dst)) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _kernels_for(src_header->size)->scatter(*dst, src, indices, src_header->used, src_header->size);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+size_t _choco_arraylist_serialize(_choco_arraylist arrlist, void* buffer, size_t capacity)
+{
+    if (arrlist == NULL) {
+        return 0;
+    }
+
+    _header* header = _choco_arraylist_get_header(arrlist);
+    size_t bytes = header->used * header->size;
+    size_t required = sizeof(_choco_arraylist_image) + bytes;
+    if (buffer == NULL || capacity < required) {
+        return required;
+    }
+
+    _choco_arraylist_image image = { .size = header->size, .length = header->used };
+    memcpy(buffer, &image, sizeof(image));
+    if (bytes > 0) {
+        memcpy((char*)buffer + sizeof(image), arrlist, bytes);
+    }
+    return required;
+}
+
+_choco_arraylist _choco_arraylist_deserialize(_allocator allocator, const void* buffer, size_t length)
+{
+    if (buffer == NULL || length < sizeof(_choco_arraylist_image)) {
+        return NULL;
+    }
+
+    _choco_arraylist_image image;
+    memcpy(&image, buffer, sizeof(image));
+    size_t available = length - sizeof(image);
+    if (image.size == 0 || image.length > available / image.size) {
+        return NULL;
+    }
+
+    _choco_arraylist arrlist = _choco_arraylist_create(allocator, image.size, image.length);
+    arrlist = _choco_arraylist_add_n(arrlist, image.length);
+    if (_choco_arraylist_length(arrlist) != image.length) {
+        _choco_arraylist_destroy(arrlist);
+        return NULL;
+    }
+
+    if (image.length > 0) {
+        memcpy(arrlist, (const char*)buffer + sizeof(image), image.length * image.size);
+    }
+    return arrlist;
+}
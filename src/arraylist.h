@@ -3,10 +3,16 @@
 */
 
 #pragma once
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef void* _choco_arraylist;
 
 typedef enum _choco_arraylist_result {
@@ -16,29 +22,72 @@ typedef enum _choco_arraylist_result {
     _CHOCO_ARRAYLIST_RESULT_NO,
 } _choco_arraylist_result;
 
+// `self` points to a copy of the allocator, which gives access to `context`. `reallocate` is
+// optional: when set, it resizes a block in place or moves it, and returns NULL to let the
+// caller fall back to allocate, copy and deallocate.
 typedef struct _choco_arraylist_allocator {
     void*(*allocate)(void* self, size_t size);
     void(*deallocate)(void* self, void* ptr);
+    void*(*reallocate)(void* self, void* ptr, size_t old_size, size_t size);
+    void* context;
 } _choco_arraylist_allocator;
 
+// The header is aligned like `max_align_t`, so that its size is a multiple of that alignment
+// and the elements that follow it are aligned for any type.
+#ifdef __cplusplus
+#define _CHOCO_ARRAYLIST_HEADER_ALIGNMENT alignas(max_align_t)
+#else
+#define _CHOCO_ARRAYLIST_HEADER_ALIGNMENT _Alignas(max_align_t)
+#endif
+
 typedef struct _choco_arraylist_header {
-    _choco_arraylist data;
+    _CHOCO_ARRAYLIST_HEADER_ALIGNMENT _choco_arraylist data;
     _choco_arraylist_allocator allocator;
     size_t allocated;
     size_t used;
     size_t size;
+    size_t refs; // handles sharing the buffer: the owner plus live snapshots.
 } _choco_arraylist_header;
 
+// Serialized form of a list: this prefix, then the elements back to back, in host byte order.
+typedef struct _choco_arraylist_image {
+    uint64_t size;
+    uint64_t length;
+} _choco_arraylist_image;
+
 _choco_arraylist_allocator _choco_arraylist_heap_allocator(void);
 _choco_arraylist_header* _choco_arraylist_get_header(_choco_arraylist arrlist);
 _choco_arraylist_result _choco_arraylist_destroy(_choco_arraylist arrlist);
-_choco_arraylist_result _choco_arraylist_remove(_choco_arraylist arrlist);
-_choco_arraylist_result _choco_arraylist_swap(_choco_arraylist arrlist, size_t a, size_t b);
+_choco_arraylist_result _choco_arraylist_remove(_choco_arraylist* arrlist);
+_choco_arraylist_result _choco_arraylist_swap(_choco_arraylist* arrlist, size_t a, size_t b);
+_choco_arraylist_result _choco_arraylist_reverse(_choco_arraylist* arrlist);
+_choco_arraylist_result _choco_arraylist_rotate(_choco_arraylist* arrlist, size_t shift);
+_choco_arraylist_result _choco_arraylist_apply_permutation(_choco_arraylist* arrlist, const size_t* indices);
+_choco_arraylist_result _choco_arraylist_gather(_choco_arraylist* dst, _choco_arraylist src, const size_t* indices, size_t count);
+_choco_arraylist_result _choco_arraylist_scatter(_choco_arraylist* dst, _choco_arraylist src, const size_t* indices);
 _choco_arraylist_result _choco_arraylist_is_full(_choco_arraylist arrlist);
+_choco_arraylist_result _choco_arraylist_is_shared(_choco_arraylist arrlist);
+_choco_arraylist_result _choco_arraylist_release(_choco_arraylist snapshot);
 _choco_arraylist _choco_arraylist_create(_choco_arraylist_allocator allocator, size_t size, size_t allocated);
 _choco_arraylist _choco_arraylist_resize(_choco_arraylist arrlist, size_t desired);
 _choco_arraylist _choco_arraylist_add(_choco_arraylist arrlist);
+_choco_arraylist _choco_arraylist_add_n(_choco_arraylist arrlist, size_t count);
+_choco_arraylist _choco_arraylist_snapshot(_choco_arraylist arrlist);
+_choco_arraylist _choco_arraylist_unshare(_choco_arraylist arrlist);
 size_t _choco_arraylist_element_size(_choco_arraylist arrlist);
 size_t _choco_arraylist_sizeof(_choco_arraylist arrlist);
 size_t _choco_arraylist_length(_choco_arraylist arrlist);
 void* _choco_arraylist_at(_choco_arraylist arrlist, size_t index);
+
+// Functions writing to the list take its address: a buffer shared with a snapshot is copied on
+// the first write, and `*arrlist` then points to the copy. `_choco_arraylist_at` is for reads;
+// writes go through `_choco_arraylist_at_writable`.
+void* _choco_arraylist_at_writable(_choco_arraylist* arrlist, size_t index);
+
+// Writes the list to `buffer` when `capacity` is large enough, and returns the bytes needed.
+size_t _choco_arraylist_serialize(_choco_arraylist arrlist, void* buffer, size_t capacity);
+_choco_arraylist _choco_arraylist_deserialize(_choco_arraylist_allocator allocator, const void* buffer, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
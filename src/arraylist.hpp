@@ -0,0 +1,303 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace choco {
+
+// Exposes a stateless C++ allocator as a `_choco_arraylist_allocator`. The C interface does
+// not give the size back on deallocation, so the block count is kept in front of the block.
+template <typename Alloc>
+struct allocator_adapter {
+    using block_type = std::max_align_t;
+    using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<block_type>;
+    using block_traits = std::allocator_traits<block_allocator>;
+
+    static_assert(block_traits::is_always_equal::value, "choco::allocator_adapter requires a stateless allocator");
+
+    static void* allocate(void*, size_t size) noexcept
+    {
+        try {
+            block_allocator allocator;
+            size_t count = 1 + (size + sizeof(block_type) - 1) / sizeof(block_type);
+            block_type* block = block_traits::allocate(allocator, count);
+            *reinterpret_cast<size_t*>(block) = count;
+            return block + 1;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    static void deallocate(void*, void* ptr) noexcept
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+
+        block_allocator allocator;
+        block_type* block = static_cast<block_type*>(ptr) - 1;
+        block_traits::deallocate(allocator, block, *reinterpret_cast<size_t*>(block));
+    }
+
+    static _choco_arraylist_allocator get() noexcept
+    {
+        return _choco_arraylist_allocator {
+            .allocate = &allocate,
+            .deallocate = &deallocate,
+            .reallocate = nullptr,
+            .context = nullptr,
+        };
+    }
+};
+
+// Typed, owning view over a `_choco_arraylist`. Elements live in the C buffer and are moved
+// around with `memcpy` when it grows, hence the trivially copyable requirement. Iterators are
+// plain pointers, so the storage can be handed to any `<algorithm>`, including the parallel
+// overloads taking an execution policy.
+template <typename T, typename Alloc = std::allocator<T>>
+class arraylist {
+    static_assert(std::is_trivially_copyable_v<T>, "choco::arraylist stores trivially copyable types");
+    static_assert(sizeof(_choco_arraylist_header) % alignof(T) == 0 && alignof(T) <= alignof(std::max_align_t),
+        "choco::arraylist cannot align this type after the arraylist header");
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    arraylist() noexcept = default;
+
+    explicit arraylist(size_type capacity)
+        : m_list(_choco_arraylist_create(allocator_adapter<Alloc>::get(), sizeof(T), capacity))
+    {
+        if (m_list == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+
+    arraylist(const arraylist&) = delete;
+    arraylist& operator=(const arraylist&) = delete;
+
+    arraylist(arraylist&& other) noexcept
+        : m_list(std::exchange(other.m_list, nullptr))
+    {
+    }
+
+    arraylist& operator=(arraylist&& other) noexcept
+    {
+        if (this != &other) {
+            reset(std::exchange(other.m_list, nullptr));
+        }
+        return *this;
+    }
+
+    ~arraylist()
+    {
+        reset(nullptr);
+    }
+
+    // Takes ownership of a list created with `sizeof(T)` elements.
+    static arraylist adopt(_choco_arraylist list)
+    {
+        if (list != nullptr && _choco_arraylist_element_size(list) != sizeof(T)) {
+            throw std::invalid_argument("choco::arraylist::adopt: element size mismatch");
+        }
+
+        arraylist result;
+        result.m_list = list;
+        return result;
+    }
+
+    // Gives up ownership of the underlying list.
+    _choco_arraylist release() noexcept
+    {
+        return std::exchange(m_list, nullptr);
+    }
+
+    _choco_arraylist native() const noexcept
+    {
+        return m_list;
+    }
+
+    // Deep copy. Copies are never implicit.
+    arraylist clone() const
+    {
+        arraylist result(capacity());
+        if (!empty()) {
+            std::memcpy(result.m_list, m_list, size() * sizeof(T));
+            result.header()->used = size();
+        }
+        return result;
+    }
+
+    size_type size() const noexcept { return _choco_arraylist_length(m_list); }
+    size_type capacity() const noexcept { return m_list == nullptr ? 0 : header()->allocated; }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Mutable access first copies the buffer when a snapshot of the native list still shares it,
+    // so that writes through the returned pointers never reach the snapshot.
+    T* data()
+    {
+        make_unique();
+        return static_cast<T*>(m_list);
+    }
+    const T* data() const noexcept { return static_cast<const T*>(m_list); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    std::span<T> span() { return { data(), size() }; }
+    std::span<const T> span() const noexcept { return { data(), size() }; }
+    operator std::span<T>() { return span(); }
+    operator std::span<const T>() const noexcept { return span(); }
+
+    T& operator[](size_type index) { return data()[index]; }
+    const T& operator[](size_type index) const noexcept { return data()[index]; }
+
+    T& at(size_type index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range("choco::arraylist::at");
+        }
+        return data()[index];
+    }
+
+    const T& at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("choco::arraylist::at");
+        }
+        return data()[index];
+    }
+
+    T& front() { return data()[0]; }
+    T& back() { return data()[size() - 1]; }
+    const T& front() const noexcept { return data()[0]; }
+    const T& back() const noexcept { return data()[size() - 1]; }
+
+    void reserve(size_type desired)
+    {
+        if (m_list == nullptr) {
+            *this = arraylist(desired);
+            return;
+        }
+
+        if (desired <= capacity()) {
+            return;
+        }
+
+        _choco_arraylist resized = _choco_arraylist_resize(m_list, desired);
+        if (_choco_arraylist_get_header(resized)->allocated < desired) {
+            throw std::bad_alloc();
+        }
+        m_list = resized;
+    }
+
+    // Constructs the element in place. Unlike `_choco_arraylist_add`, the slot is not zeroed
+    // first, and `emplace_back()` leaves a trivially default constructible `T` uninitialized.
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (size() >= capacity()) {
+            if constexpr (sizeof...(Args) > 0) {
+                // The arguments may refer to an element of this list, whose buffer is freed
+                // when it grows, so the element is built first, as `std::vector` does.
+                T value(std::forward<Args>(args)...);
+                reserve((capacity() + 1) * 2);
+                return construct_back(std::move(value));
+            }
+            reserve((capacity() + 1) * 2);
+        }
+        return construct_back(std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void pop_back()
+    {
+        make_unique();
+        _choco_arraylist_remove(&m_list);
+    }
+
+    void clear()
+    {
+        if (m_list != nullptr) {
+            make_unique();
+            header()->used = 0;
+        }
+    }
+
+private:
+    template <typename... Args>
+    T& construct_back(Args&&... args)
+    {
+        make_unique();
+
+        void* slot = data() + size();
+        T* element;
+        if constexpr (sizeof...(Args) == 0 && std::is_trivially_default_constructible_v<T>) {
+            element = ::new (slot) T;
+        } else {
+            element = ::new (slot) T(std::forward<Args>(args)...);
+        }
+        header()->used++;
+        return *element;
+    }
+
+    _choco_arraylist_header* header() const noexcept
+    {
+        return _choco_arraylist_get_header(m_list);
+    }
+
+    // Copies the buffer if a snapshot of the native list still shares it.
+    void make_unique()
+    {
+        if (_choco_arraylist_is_shared(m_list) == _CHOCO_ARRAYLIST_RESULT_YES) {
+            _choco_arraylist unique = _choco_arraylist_unshare(m_list);
+            if (unique == m_list) {
+                throw std::bad_alloc();
+            }
+            m_list = unique;
+        }
+    }
+
+    void reset(_choco_arraylist list) noexcept
+    {
+        if (m_list != nullptr) {
+            _choco_arraylist_destroy(m_list);
+        }
+        m_list = list;
+    }
+
+    _choco_arraylist m_list = nullptr;
+};
+
+}
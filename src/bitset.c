@@ -0,0 +1,377 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "bitset.h"
+#include "cpu.h"
+#include <immintrin.h>
+
+typedef _choco_bitset_header _header;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _WORD_BITS (64)
+
+#define _words_for(bits) \
+    (((bits) + _WORD_BITS - 1) / _WORD_BITS)
+
+#define _physical_size(words) \
+    (sizeof(_header) + sizeof(uint64_t) * (words))
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _get_header(bitset) \
+    (((_header*)bitset) - 1)
+
+// Bulk operations are generated twice: a scalar loop and an AVX2 loop handling four words per
+// iteration. The AVX2 loop hands the remaining words to the scalar one.
+#define _define_bulk_op(name, scalar_op, avx2_op)                                              \
+    static void _##name##_scalar(uint64_t* dst, const uint64_t* src, size_t count)             \
+    {                                                                                          \
+        for (size_t i = 0; i < count; i++) {                                                   \
+            uint64_t a = dst[i], b = src[i];                                                   \
+            dst[i] = scalar_op;                                                                \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    __attribute__((target("avx2"))) static void _##name##_avx2(uint64_t* dst, const uint64_t* src, size_t count) \
+    {                                                                                          \
+        size_t i = 0;                                                                          \
+        for (; i + 4 <= count; i += 4) {                                                       \
+            __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));                         \
+            __m256i b = _mm256_loadu_si256((const __m256i*)(src + i));                         \
+            _mm256_storeu_si256((__m256i*)(dst + i), avx2_op);                                 \
+        }                                                                                      \
+        _##name##_scalar(dst + i, src + i, count - i);                                         \
+    }
+
+_define_bulk_op(and, a & b, _mm256_and_si256(a, b))
+_define_bulk_op(or, a | b, _mm256_or_si256(a, b))
+_define_bulk_op(xor, a ^ b, _mm256_xor_si256(a, b))
+_define_bulk_op(andnot, a & ~b, _mm256_andnot_si256(b, a))
+
+typedef void (*_bulk_op)(uint64_t* dst, const uint64_t* src, size_t count);
+
+static size_t _popcount_scalar(const uint64_t* words, size_t count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += __builtin_popcountll(words[i]);
+    }
+    return total;
+}
+
+__attribute__((target("popcnt"))) static size_t _popcount_native(const uint64_t* words, size_t count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += __builtin_popcountll(words[i]);
+    }
+    return total;
+}
+
+static size_t _popcount_words(const uint64_t* words, size_t count)
+{
+    if (_choco_cpu_features() & _CHOCO_CPU_POPCNT) {
+        return _popcount_native(words, count);
+    }
+    return _popcount_scalar(words, count);
+}
+
+static _result _apply(_choco_bitset dst, _choco_bitset src, _bulk_op scalar, _bulk_op avx2)
+{
+    if (dst == NULL || src == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* dst_header = _get_header(dst);
+    _header* src_header = _get_header(src);
+
+    if (dst_header->used != src_header->used) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t count = _words_for(dst_header->used);
+    if (_choco_cpu_features() & _CHOCO_CPU_AVX2) {
+        avx2(dst, src, count);
+    } else {
+        scalar(dst, src, count);
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+// Moves the words to a buffer of `words` words. New words are cleared so that the bits past
+// `used` stay cleared.
+static _choco_bitset _reserve(_choco_bitset bitset, size_t words)
+{
+    _header* header = _get_header(bitset);
+    _allocator allocator = header->allocator;
+    if (!_is_allocator_valid(allocator)) {
+        return bitset;
+    }
+
+    _header* new_header = allocator.allocate(&allocator, _physical_size(words));
+    if (new_header == NULL) {
+        return bitset;
+    }
+
+    *new_header = (_header) {
+        .allocated = words,
+        .allocator = allocator,
+        .used = header->used,
+        .data = (uint64_t*)(new_header + 1),
+    };
+
+    memcpy(new_header->data, bitset, sizeof(uint64_t) * header->allocated);
+    memset(new_header->data + header->allocated, 0, sizeof(uint64_t) * (words - header->allocated));
+    allocator.deallocate(&allocator, header);
+    return new_header->data;
+}
+
+_choco_bitset _choco_bitset_create(_allocator allocator, size_t length)
+{
+    if (!_is_allocator_valid(allocator)) {
+        return NULL;
+    }
+
+    size_t words = _words_for(length);
+    _header* header = allocator.allocate(&allocator, _physical_size(words));
+    if (header == NULL) {
+        return NULL;
+    }
+
+    *header = (_header) {
+        .allocated = words,
+        .allocator = allocator,
+        .data = (uint64_t*)(header + 1),
+        .used = length
+    };
+
+    memset(header->data, 0, sizeof(uint64_t) * words);
+    return header->data;
+}
+
+_header* _choco_bitset_get_header(_choco_bitset bitset)
+{
+    if (bitset == NULL) {
+        return NULL;
+    }
+
+    return _get_header(bitset);
+}
+
+_result _choco_bitset_destroy(_choco_bitset bitset)
+{
+    if (bitset == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* header = _get_header(bitset);
+    _allocator allocator = header->allocator;
+
+    if (!_is_allocator_valid(allocator)) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    allocator.deallocate(&allocator, header);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+size_t _choco_bitset_length(_choco_bitset bitset)
+{
+    if (bitset == NULL) {
+        return 0;
+    }
+
+    return _get_header(bitset)->used;
+}
+
+_choco_bitset _choco_bitset_resize(_choco_bitset bitset, size_t length)
+{
+    if (bitset == NULL) {
+        return NULL;
+    }
+
+    _header* header = _get_header(bitset);
+    size_t words = _words_for(length);
+
+    if (words > header->allocated) {
+        bitset = _reserve(bitset, words);
+        header = _get_header(bitset);
+        if (words > header->allocated) {
+            return bitset;
+        }
+    }
+
+    if (length < header->used) {
+        size_t old_words = _words_for(header->used);
+        if (length % _WORD_BITS != 0) {
+            bitset[words - 1] &= (UINT64_C(1) << (length % _WORD_BITS)) - 1;
+        }
+        memset(bitset + words, 0, sizeof(uint64_t) * (old_words - words));
+    }
+
+    header->used = length;
+    return bitset;
+}
+
+_choco_bitset _choco_bitset_push(_choco_bitset bitset, int value)
+{
+    if (bitset == NULL) {
+        return NULL;
+    }
+
+    _header* header = _get_header(bitset);
+
+    if (header->used >= header->allocated * _WORD_BITS) {
+        bitset = _reserve(bitset, (header->allocated + 1) * 2);
+        header = _get_header(bitset);
+        if (header->used >= header->allocated * _WORD_BITS) {
+            return bitset;
+        }
+    }
+
+    size_t index = header->used++;
+    if (value) {
+        bitset[index / _WORD_BITS] |= UINT64_C(1) << (index % _WORD_BITS);
+    }
+    return bitset;
+}
+
+_result _choco_bitset_set(_choco_bitset bitset, size_t index, int value)
+{
+    if (bitset == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* header = _get_header(bitset);
+
+    if (index >= header->used) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    uint64_t mask = UINT64_C(1) << (index % _WORD_BITS);
+    if (value) {
+        bitset[index / _WORD_BITS] |= mask;
+    } else {
+        bitset[index / _WORD_BITS] &= ~mask;
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_bitset_test(_choco_bitset bitset, size_t index)
+{
+    if (bitset == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _header* header = _get_header(bitset);
+
+    if (index >= header->used) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    uint64_t word = bitset[index / _WORD_BITS] >> (index % _WORD_BITS);
+    return (word & 1) ? _CHOCO_ARRAYLIST_RESULT_YES : _CHOCO_ARRAYLIST_RESULT_NO;
+}
+
+size_t _choco_bitset_popcount(_choco_bitset bitset)
+{
+    if (bitset == NULL) {
+        return 0;
+    }
+
+    return _popcount_words(bitset, _words_for(_get_header(bitset)->used));
+}
+
+size_t _choco_bitset_find_first_set(_choco_bitset bitset, size_t from)
+{
+    if (bitset == NULL) {
+        return 0;
+    }
+
+    _header* header = _get_header(bitset);
+
+    if (from >= header->used) {
+        return header->used;
+    }
+
+    size_t count = _words_for(header->used);
+    size_t index = from / _WORD_BITS;
+    uint64_t word = bitset[index] & (~UINT64_C(0) << (from % _WORD_BITS));
+
+    while (word == 0) {
+        if (++index >= count) {
+            return header->used;
+        }
+        word = bitset[index];
+    }
+
+    return index * _WORD_BITS + __builtin_ctzll(word);
+}
+
+size_t _choco_bitset_rank(_choco_bitset bitset, size_t index)
+{
+    if (bitset == NULL) {
+        return 0;
+    }
+
+    _header* header = _get_header(bitset);
+
+    if (index > header->used) {
+        index = header->used;
+    }
+
+    size_t full = index / _WORD_BITS;
+    size_t rank = _popcount_words(bitset, full);
+    if (index % _WORD_BITS != 0) {
+        uint64_t partial = bitset[full] & ((UINT64_C(1) << (index % _WORD_BITS)) - 1);
+        rank += __builtin_popcountll(partial);
+    }
+    return rank;
+}
+
+size_t _choco_bitset_select(_choco_bitset bitset, size_t rank)
+{
+    if (bitset == NULL) {
+        return 0;
+    }
+
+    _header* header = _get_header(bitset);
+    size_t count = _words_for(header->used);
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t word = bitset[i];
+        size_t set = __builtin_popcountll(word);
+        if (rank < set) {
+            for (; rank > 0; rank--) {
+                word &= word - 1;
+            }
+            return i * _WORD_BITS + __builtin_ctzll(word);
+        }
+        rank -= set;
+    }
+
+    return header->used;
+}
+
+_result _choco_bitset_and(_choco_bitset dst, _choco_bitset src)
+{
+    return _apply(dst, src, _and_scalar, _and_avx2);
+}
+
+_result _choco_bitset_or(_choco_bitset dst, _choco_bitset src)
+{
+    return _apply(dst, src, _or_scalar, _or_avx2);
+}
+
+_result _choco_bitset_xor(_choco_bitset dst, _choco_bitset src)
+{
+    return _apply(dst, src, _xor_scalar, _xor_avx2);
+}
+
+_result _choco_bitset_andnot(_choco_bitset dst, _choco_bitset src)
+{
+    return _apply(dst, src, _andnot_scalar, _andnot_avx2);
+}
@@ -0,0 +1,43 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t* _choco_bitset;
+
+// Same layout as the arraylist: the header sits right before the words. `allocated` counts
+// words, `used` counts bits. Bits past `used` in the last word are always cleared.
+typedef struct _choco_bitset_header {
+    _choco_bitset data;
+    _choco_arraylist_allocator allocator;
+    size_t allocated;
+    size_t used;
+} _choco_bitset_header;
+
+_choco_bitset_header* _choco_bitset_get_header(_choco_bitset bitset);
+_choco_arraylist_result _choco_bitset_destroy(_choco_bitset bitset);
+_choco_arraylist_result _choco_bitset_set(_choco_bitset bitset, size_t index, int value);
+_choco_arraylist_result _choco_bitset_test(_choco_bitset bitset, size_t index);
+_choco_arraylist_result _choco_bitset_and(_choco_bitset dst, _choco_bitset src);
+_choco_arraylist_result _choco_bitset_or(_choco_bitset dst, _choco_bitset src);
+_choco_arraylist_result _choco_bitset_xor(_choco_bitset dst, _choco_bitset src);
+_choco_arraylist_result _choco_bitset_andnot(_choco_bitset dst, _choco_bitset src);
+_choco_bitset _choco_bitset_create(_choco_arraylist_allocator allocator, size_t length);
+_choco_bitset _choco_bitset_resize(_choco_bitset bitset, size_t length);
+_choco_bitset _choco_bitset_push(_choco_bitset bitset, int value);
+size_t _choco_bitset_length(_choco_bitset bitset);
+size_t _choco_bitset_popcount(_choco_bitset bitset);
+size_t _choco_bitset_find_first_set(_choco_bitset bitset, size_t from);
+size_t _choco_bitset_rank(_choco_bitset bitset, size_t index);
+size_t _choco_bitset_select(_choco_bitset bitset, size_t rank);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,288 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "bloblist.h"
+
+typedef _choco_bloblist _list;
+typedef _choco_bloblist_entry _entry;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _INITIAL_TABLE (16)
+#define _MULTIPLIER UINT64_C(0x9E3779B97F4A7C15)
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _get_offsets(list) \
+    ((uint64_t*)(list)->offsets)
+
+// Multiplicative hash over 8 byte words; short strings take one or two rounds.
+static uint64_t _hash(const void* bytes, size_t length)
+{
+    const unsigned char* data = bytes;
+    uint64_t hash = length * _MULTIPLIER;
+
+    for (; length >= 8; data += 8, length -= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        hash = (hash ^ word) * _MULTIPLIER;
+        hash ^= hash >> 32;
+    }
+
+    if (length > 0) {
+        uint64_t word = 0;
+        memcpy(&word, data, length);
+        hash = (hash ^ word) * _MULTIPLIER;
+        hash ^= hash >> 32;
+    }
+
+    hash *= _MULTIPLIER;
+    return hash ^ (hash >> 29);
+}
+
+static const void* _blob(const _list* list, size_t index, size_t* length)
+{
+    const uint64_t* offsets = _get_offsets(list);
+    *length = offsets[index + 1] - offsets[index];
+    return (const char*)list->bytes + offsets[index];
+}
+
+// Linear probing: the entry holding the blob, or the empty entry where it would go.
+static _entry* _probe(const _list* list, const void* bytes, size_t length, uint64_t hash)
+{
+    _entry* entries = (_entry*)list->table;
+    size_t mask = _choco_arraylist_length(list->table) - 1;
+    uint32_t tag = (uint32_t)(hash >> 32);
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        _entry* entry = &entries[i];
+        if (entry->index == 0) {
+            return entry;
+        }
+
+        if (entry->tag == tag) {
+            size_t stored_length;
+            const void* stored = _blob(list, entry->index - 1, &stored_length);
+            if (stored_length == length && (length == 0 || memcmp(stored, bytes, length) == 0)) {
+                return entry;
+            }
+        }
+    }
+}
+
+static _result _rehash(_list* list, size_t entries)
+{
+    _choco_arraylist table = _choco_arraylist_create(list->allocator, sizeof(_entry), entries);
+    table = _choco_arraylist_add_n(table, entries);
+    if (_choco_arraylist_length(table) != entries) {
+        _choco_arraylist_destroy(table);
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _choco_arraylist old = list->table;
+    list->table = table;
+    _choco_arraylist_destroy(old);
+
+    size_t count = _choco_bloblist_length(list);
+    for (size_t i = 0; i < count; i++) {
+        size_t length;
+        const void* bytes = _blob(list, i, &length);
+        uint64_t hash = _hash(bytes, length);
+        *_probe(list, bytes, length, hash) = (_entry) { .tag = (uint32_t)(hash >> 32), .index = (uint32_t)(i + 1) };
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+// Appends the bytes of `count` blobs with lengths `lengths`, without looking at the table.
+static _result _append(_list* list, const void* bytes, const size_t* lengths, size_t count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += lengths[i];
+    }
+
+    // Growing the arena can move it, so a source taken from this list is kept as an offset.
+    size_t used = _choco_arraylist_length(list->bytes);
+    uintptr_t source = (uintptr_t)bytes - (uintptr_t)list->bytes;
+    int inside = bytes != NULL && source < used;
+    list->bytes = _choco_arraylist_add_n(list->bytes, total);
+    if (_choco_arraylist_length(list->bytes) != used + total) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t blobs = _choco_arraylist_length(list->offsets);
+    list->offsets = _choco_arraylist_add_n(list->offsets, count);
+    if (_choco_arraylist_length(list->offsets) != blobs + count) {
+        _choco_arraylist_get_header(list->bytes)->used = used;
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    if (total > 0) {
+        memcpy((char*)list->bytes + used, inside ? (char*)list->bytes + source : bytes, total);
+    }
+    uint64_t* offsets = _get_offsets(list);
+    for (size_t i = 0; i < count; i++) {
+        offsets[blobs + i] = offsets[blobs + i - 1] + lengths[i];
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_list* _choco_bloblist_create(_allocator allocator, _choco_bloblist_mode mode)
+{
+    if (!_is_allocator_valid(allocator)) {
+        return NULL;
+    }
+
+    if (mode != _CHOCO_BLOBLIST_PLAIN && mode != _CHOCO_BLOBLIST_INTERN) {
+        return NULL;
+    }
+
+    _list* list = allocator.allocate(&allocator, sizeof(_list));
+    if (list == NULL) {
+        return NULL;
+    }
+
+    *list = (_list) {
+        .allocator = allocator,
+        .bytes = _choco_arraylist_create(allocator, sizeof(char), 256),
+        .offsets = _choco_arraylist_create(allocator, sizeof(uint64_t), 16),
+        .table = NULL,
+    };
+
+    list->offsets = _choco_arraylist_add(list->offsets);
+    int failed = list->bytes == NULL || _choco_arraylist_length(list->offsets) != 1;
+    if (!failed && mode == _CHOCO_BLOBLIST_INTERN) {
+        failed = _rehash(list, _INITIAL_TABLE) != _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    if (failed) {
+        _choco_bloblist_destroy(list);
+        return NULL;
+    }
+    return list;
+}
+
+_result _choco_bloblist_destroy(_list* list)
+{
+    if (list == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _allocator allocator = list->allocator;
+    _choco_arraylist_destroy(list->bytes);
+    _choco_arraylist_destroy(list->offsets);
+    _choco_arraylist_destroy(list->table);
+    allocator.deallocate(&allocator, list);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_bloblist_push(_list* list, const void* bytes, size_t length, size_t* index)
+{
+    if (list == NULL || (bytes == NULL && length > 0)) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t count = _choco_bloblist_length(list);
+    if (list->table == NULL) {
+        if (_append(list, bytes, &length, 1) != _CHOCO_ARRAYLIST_RESULT_OK) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+
+        if (index != NULL) {
+            *index = count;
+        }
+        return _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    uint64_t hash = _hash(bytes, length);
+    _entry* entry = _probe(list, bytes, length, hash);
+
+    if (entry->index == 0) {
+        // Keeps the table at most half full, so that probes stay short.
+        size_t entries = _choco_arraylist_length(list->table);
+        if (count >= UINT32_MAX - 1) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+
+        if (2 * (count + 1) > entries) {
+            if (_rehash(list, 2 * entries) != _CHOCO_ARRAYLIST_RESULT_OK) {
+                return _CHOCO_ARRAYLIST_RESULT_ERROR;
+            }
+            entry = _probe(list, bytes, length, hash);
+        }
+
+        if (_append(list, bytes, &length, 1) != _CHOCO_ARRAYLIST_RESULT_OK) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+        *entry = (_entry) { .tag = (uint32_t)(hash >> 32), .index = (uint32_t)(count + 1) };
+    }
+
+    if (index != NULL) {
+        *index = entry->index - 1;
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_bloblist_append_n(_list* list, const void* bytes, const size_t* lengths, size_t count)
+{
+    if (list == NULL || (count > 0 && (bytes == NULL || lengths == NULL))) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    if (list->table == NULL) {
+        return _append(list, bytes, lengths, count);
+    }
+
+    const char* next = bytes;
+    for (size_t i = 0; i < count; i++) {
+        if (_choco_bloblist_push(list, next, lengths[i], NULL) != _CHOCO_ARRAYLIST_RESULT_OK) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+        next += lengths[i];
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+const void* _choco_bloblist_get(const _list* list, size_t index, size_t* length)
+{
+    if (list == NULL || length == NULL || index >= _choco_bloblist_length(list)) {
+        return NULL;
+    }
+
+    return _blob(list, index, length);
+}
+
+size_t _choco_bloblist_find(const _list* list, const void* bytes, size_t length)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    if (list->table == NULL || (bytes == NULL && length > 0)) {
+        return _choco_bloblist_length(list);
+    }
+
+    _entry* entry = _probe(list, bytes, length, _hash(bytes, length));
+    return entry->index != 0 ? entry->index - 1 : _choco_bloblist_length(list);
+}
+
+size_t _choco_bloblist_length(const _list* list)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    return _choco_arraylist_length(list->offsets) - 1;
+}
+
+size_t _choco_bloblist_sizeof(const _list* list)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    return sizeof(_list) + _choco_arraylist_sizeof(list->bytes) + _choco_arraylist_sizeof(list->offsets)
+        + _choco_arraylist_sizeof(list->table);
+}
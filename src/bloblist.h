@@ -0,0 +1,58 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum _choco_bloblist_mode {
+    _CHOCO_BLOBLIST_PLAIN,
+    // Identical blobs are stored once; pushing one again returns the index of the first copy.
+    _CHOCO_BLOBLIST_INTERN,
+} _choco_bloblist_mode;
+
+// Entry of the intern table: the high bits of the hash of the blob, and its index + 1
+// (0 for an empty entry).
+typedef struct _choco_bloblist_entry {
+    uint32_t tag;
+    uint32_t index;
+} _choco_bloblist_entry;
+
+// Append-only list of byte strings. All the bytes are kept back to back in `bytes`; blob `i`
+// spans `offsets[i]` to `offsets[i + 1]`. `table` is NULL unless the list interns.
+typedef struct _choco_bloblist {
+    _choco_arraylist_allocator allocator;
+    _choco_arraylist bytes;
+    _choco_arraylist offsets;
+    _choco_arraylist table;
+} _choco_bloblist;
+
+_choco_bloblist* _choco_bloblist_create(_choco_arraylist_allocator allocator, _choco_bloblist_mode mode);
+_choco_arraylist_result _choco_bloblist_destroy(_choco_bloblist* list);
+
+// Stores the index of the blob in `index` when not NULL. Interning lists hold at most 2^32 - 1
+// blobs.
+_choco_arraylist_result _choco_bloblist_push(_choco_bloblist* list, const void* bytes, size_t length, size_t* index);
+
+// Appends `count` blobs stored back to back in `bytes`, growing the buffers once.
+_choco_arraylist_result _choco_bloblist_append_n(_choco_bloblist* list, const void* bytes, const size_t* lengths, size_t count);
+
+// Returns the blob and its length in `length`, or NULL when out of range. The pointer is only
+// valid until the next push.
+const void* _choco_bloblist_get(const _choco_bloblist* list, size_t index, size_t* length);
+
+// Index of an interned blob, or the length of the list when it is not there or the list does
+// not intern.
+size_t _choco_bloblist_find(const _choco_bloblist* list, const void* bytes, size_t length);
+
+size_t _choco_bloblist_length(const _choco_bloblist* list);
+size_t _choco_bloblist_sizeof(const _choco_bloblist* list);
+
+#ifdef __cplusplus
+}
+#endif
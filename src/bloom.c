@@ -0,0 +1,277 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "bloom.h"
+#include "cpu.h"
+#include <immintrin.h>
+
+typedef _choco_bloom _filter;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _BLOCK _CHOCO_BLOOM_BLOCK
+#define _WORDS (_BLOCK / sizeof(uint64_t))
+#define _BATCH (16)
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _round_up(value, granule) \
+    (((value) + (granule) - 1) / (granule) * (granule))
+
+// Odd multipliers picking the bit of each word from the low half of the hash.
+static const uint32_t _SALTS[_WORDS] = {
+    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+    0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+};
+
+static uint64_t _mix(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= UINT64_C(0xff51afd7ed558ccd);
+    key ^= key >> 33;
+    key *= UINT64_C(0xc4ceb9fe1a85ec53);
+    return key ^ (key >> 33);
+}
+
+// The high half of the hash picks the block, without a division.
+static uint64_t* _block(const _filter* filter, uint64_t hash)
+{
+    size_t index = (size_t)(((hash >> 32) * filter->count) >> 32);
+    return filter->blocks + index * _WORDS;
+}
+
+static void _add_scalar(uint64_t* block, uint32_t hash)
+{
+    for (size_t i = 0; i < _WORDS; i++) {
+        block[i] |= UINT64_C(1) << ((hash * _SALTS[i]) >> 26);
+    }
+}
+
+static int _test_scalar(const uint64_t* block, uint32_t hash)
+{
+    for (size_t i = 0; i < _WORDS; i++) {
+        if ((block[i] & (UINT64_C(1) << ((hash * _SALTS[i]) >> 26))) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Computes the 8 bit positions at once, then widens them to one mask per 64 bit word.
+__attribute__((target("avx2"))) static inline void _masks_avx2(uint32_t hash, __m256i* low, __m256i* high)
+{
+    const __m256i one = _mm256_set1_epi64x(1);
+    __m256i salts = _mm256_loadu_si256((const __m256i*)_SALTS);
+    __m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)hash), salts), 26);
+    *low = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(bits)));
+    *high = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(bits, 1)));
+}
+
+__attribute__((target("avx2"))) static void _add_avx2(uint64_t* block, uint32_t hash)
+{
+    __m256i low, high;
+    _masks_avx2(hash, &low, &high);
+    __m256i* words = (__m256i*)block;
+    _mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words), low));
+    _mm256_store_si256(words + 1, _mm256_or_si256(_mm256_load_si256(words + 1), high));
+}
+
+__attribute__((target("avx2"))) static int _test_avx2(const uint64_t* block, uint32_t hash)
+{
+    __m256i low, high;
+    _masks_avx2(hash, &low, &high);
+    const __m256i* words = (const __m256i*)block;
+    return _mm256_testc_si256(_mm256_load_si256(words), low) & _mm256_testc_si256(_mm256_load_si256(words + 1), high);
+}
+
+static void (*_select_add(void))(uint64_t*, uint32_t)
+{
+    return (_choco_cpu_features() & _CHOCO_CPU_AVX2) ? _add_avx2 : _add_scalar;
+}
+
+static int (*_select_test(void))(const uint64_t*, uint32_t)
+{
+    return (_choco_cpu_features() & _CHOCO_CPU_AVX2) ? _test_avx2 : _test_scalar;
+}
+
+static _filter* _create(_allocator allocator, size_t count)
+{
+    _filter* filter = allocator.allocate(&allocator, sizeof(_filter));
+    if (filter == NULL) {
+        return NULL;
+    }
+
+    filter->allocator = allocator;
+    filter->count = count;
+    filter->storage = _choco_arraylist_create(allocator, _BLOCK, count + 1);
+    filter->storage = _choco_arraylist_add_n(filter->storage, count + 1);
+    if (_choco_arraylist_length(filter->storage) != count + 1) {
+        _choco_bloom_destroy(filter);
+        return NULL;
+    }
+
+    filter->blocks = (uint64_t*)_round_up((uintptr_t)filter->storage, _BLOCK);
+    return filter;
+}
+
+_filter* _choco_bloom_create(_allocator allocator, size_t expected, size_t bits_per_key)
+{
+    if (!_is_allocator_valid(allocator) || bits_per_key == 0) {
+        return NULL;
+    }
+
+    if (expected > SIZE_MAX / bits_per_key) {
+        return NULL;
+    }
+
+    size_t count = _round_up(expected * bits_per_key, 8 * _BLOCK) / (8 * _BLOCK);
+    if (count > UINT32_MAX) {
+        return NULL;
+    }
+    return _create(allocator, count > 0 ? count : 1);
+}
+
+_result _choco_bloom_destroy(_filter* filter)
+{
+    if (filter == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _allocator allocator = filter->allocator;
+    _choco_arraylist_destroy(filter->storage);
+    allocator.deallocate(&allocator, filter);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_bloom_add(_filter* filter, uint64_t key)
+{
+    if (filter == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    uint64_t hash = _mix(key);
+    _select_add()(_block(filter, hash), (uint32_t)hash);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_bloom_contains(const _filter* filter, uint64_t key)
+{
+    if (filter == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    uint64_t hash = _mix(key);
+    return _select_test()(_block(filter, hash), (uint32_t)hash) ? _CHOCO_ARRAYLIST_RESULT_YES : _CHOCO_ARRAYLIST_RESULT_NO;
+}
+
+_result _choco_bloom_add_n(_filter* filter, const uint64_t* keys, size_t count)
+{
+    if (filter == NULL || (keys == NULL && count > 0)) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    void (*add)(uint64_t*, uint32_t) = _select_add();
+    uint64_t hashes[_BATCH];
+
+    for (size_t i = 0; i < count; i += _BATCH) {
+        size_t batch = count - i < _BATCH ? count - i : _BATCH;
+        for (size_t j = 0; j < batch; j++) {
+            hashes[j] = _mix(keys[i + j]);
+            __builtin_prefetch(_block(filter, hashes[j]), 1);
+        }
+
+        for (size_t j = 0; j < batch; j++) {
+            add(_block(filter, hashes[j]), (uint32_t)hashes[j]);
+        }
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+size_t _choco_bloom_contains_n(const _filter* filter, const uint64_t* keys, size_t count, uint8_t* found)
+{
+    if (filter == NULL || keys == NULL || found == NULL) {
+        return 0;
+    }
+
+    int (*test)(const uint64_t*, uint32_t) = _select_test();
+    uint64_t hashes[_BATCH];
+    size_t total = 0;
+
+    for (size_t i = 0; i < count; i += _BATCH) {
+        size_t batch = count - i < _BATCH ? count - i : _BATCH;
+        for (size_t j = 0; j < batch; j++) {
+            hashes[j] = _mix(keys[i + j]);
+            __builtin_prefetch(_block(filter, hashes[j]));
+        }
+
+        for (size_t j = 0; j < batch; j++) {
+            found[i + j] = (uint8_t)test(_block(filter, hashes[j]), (uint32_t)hashes[j]);
+            total += found[i + j];
+        }
+    }
+    return total;
+}
+
+_result _choco_bloom_union(_filter* dst, const _filter* src)
+{
+    if (dst == NULL || src == NULL || dst->count != src->count) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t words = dst->count * _WORDS;
+    for (size_t i = 0; i < words; i++) {
+        dst->blocks[i] |= src->blocks[i];
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+size_t _choco_bloom_serialize(const _filter* filter, void* buffer, size_t capacity)
+{
+    if (filter == NULL) {
+        return 0;
+    }
+
+    size_t bytes = filter->count * _BLOCK;
+    size_t required = sizeof(_choco_arraylist_image) + bytes;
+    if (buffer == NULL || capacity < required) {
+        return required;
+    }
+
+    _choco_arraylist_image image = { .size = _BLOCK, .length = filter->count };
+    memcpy(buffer, &image, sizeof(image));
+    memcpy((char*)buffer + sizeof(image), filter->blocks, bytes);
+    return required;
+}
+
+_filter* _choco_bloom_deserialize(_allocator allocator, const void* buffer, size_t length)
+{
+    if (!_is_allocator_valid(allocator) || buffer == NULL || length < sizeof(_choco_arraylist_image)) {
+        return NULL;
+    }
+
+    _choco_arraylist_image image;
+    memcpy(&image, buffer, sizeof(image));
+    size_t available = length - sizeof(image);
+    if (image.size != _BLOCK || image.length == 0 || image.length > UINT32_MAX || image.length > available / _BLOCK) {
+        return NULL;
+    }
+
+    _filter* filter = _create(allocator, image.length);
+    if (filter == NULL) {
+        return NULL;
+    }
+
+    memcpy(filter->blocks, (const char*)buffer + sizeof(image), image.length * _BLOCK);
+    return filter;
+}
+
+size_t _choco_bloom_sizeof(const _filter* filter)
+{
+    if (filter == NULL) {
+        return 0;
+    }
+
+    return sizeof(_filter) + _choco_arraylist_sizeof(filter->storage);
+}
@@ -0,0 +1,50 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _CHOCO_BLOOM_BLOCK (64)
+
+// Blocked Bloom filter: a key sets 8 bits, one in each 64 bit word of a single 64 byte block,
+// so a lookup reads one cache line. `storage` holds one block more than `count`, so that
+// `blocks` can start on a cache line boundary.
+typedef struct _choco_bloom {
+    _choco_arraylist_allocator allocator;
+    _choco_arraylist storage;
+    uint64_t* blocks;
+    size_t count;
+} _choco_bloom;
+
+// Sized for `expected` keys at `bits_per_key` bits each; 10 bits give about 1% false positives.
+_choco_bloom* _choco_bloom_create(_choco_arraylist_allocator allocator, size_t expected, size_t bits_per_key);
+_choco_arraylist_result _choco_bloom_destroy(_choco_bloom* filter);
+
+// Keys are 64 bit values, usually hashes. They are mixed again, so plain integers work as well.
+_choco_arraylist_result _choco_bloom_add(_choco_bloom* filter, uint64_t key);
+_choco_arraylist_result _choco_bloom_contains(const _choco_bloom* filter, uint64_t key);
+
+// Batches prefetch the blocks of several keys before touching them, so their misses overlap.
+_choco_arraylist_result _choco_bloom_add_n(_choco_bloom* filter, const uint64_t* keys, size_t count);
+
+// Sets `found[i]` to 1 when `keys[i]` may be in the filter, and returns how many may be.
+size_t _choco_bloom_contains_n(const _choco_bloom* filter, const uint64_t* keys, size_t count, uint8_t* found);
+
+// Adds the keys of `src`, which must have the same number of blocks.
+_choco_arraylist_result _choco_bloom_union(_choco_bloom* dst, const _choco_bloom* src);
+
+// Same layout as `_choco_arraylist_serialize` on a list of the blocks, with elements of 64 bytes.
+size_t _choco_bloom_serialize(const _choco_bloom* filter, void* buffer, size_t capacity);
+_choco_bloom* _choco_bloom_deserialize(_choco_arraylist_allocator allocator, const void* buffer, size_t length);
+
+size_t _choco_bloom_sizeof(const _choco_bloom* filter);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,519 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "bptree.h"
+#include "cpu.h"
+#include <immintrin.h>
+#include <stddef.h>
+
+typedef _choco_bptree _tree;
+typedef _choco_bptree_cursor _cursor;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _KEYS _CHOCO_BPTREE_KEYS
+#define _INNER_KEYS (_KEYS - 1)
+#define _SLAB_BLOCKS (64)
+#define _NO_KEY UINT64_MAX
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+// Keys come first, so that a node search reads 4 whole cache lines. Slots past `count` hold
+// _NO_KEY, which lets the search compare full vectors.
+typedef struct _node {
+    uint64_t keys[_KEYS];
+    uint32_t count;
+    uint32_t leaf;
+    struct _node* next;
+    struct _node* children[_KEYS];
+} _node;
+
+// Leaves store their values where inner nodes store their children.
+#define _VALUES_OFFSET offsetof(_node, children)
+
+#define _get_value(tree, node, index) \
+    ((char*)(node) + _VALUES_OFFSET + (index) * (tree)->value_size)
+
+#define _min(a, b) \
+    ((a) < (b) ? (a) : (b))
+
+// Right half of a node that split, and the smallest key under it.
+typedef struct _split {
+    uint64_t key;
+    _node* right;
+} _split;
+
+// Node of a level being bulk loaded, and the smallest key under it.
+typedef struct _entry {
+    uint64_t key;
+    _node* node;
+} _entry;
+
+static size_t _count_scalar(const uint64_t* keys, size_t count, uint64_t key, int inclusive)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += inclusive ? keys[i] <= key : keys[i] < key;
+    }
+    return total;
+}
+
+// AVX2 only has signed 64 bit compares, so both sides get their sign bit flipped. The padding
+// keys are never less than `key`, and only count as equal to it when `key` is _NO_KEY.
+__attribute__((target("avx2"))) static size_t _count_avx2(const uint64_t* keys, size_t count, uint64_t key, int inclusive)
+{
+    const __m256i flip = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i needle = _mm256_xor_si256(_mm256_set1_epi64x((long long)key), flip);
+    size_t total = 0;
+
+    for (size_t i = 0; i < count; i += 4) {
+        __m256i values = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(keys + i)), flip);
+        __m256i compared = inclusive ? _mm256_cmpgt_epi64(values, needle) : _mm256_cmpgt_epi64(needle, values);
+        int bits = __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(compared)));
+        total += inclusive ? 4 - bits : bits;
+    }
+    return _min(total, count);
+}
+
+// Number of keys of `node` below `key`, or not above it when `inclusive`. Leaves look for the
+// first key not below, inner nodes for the child holding `key`.
+static size_t _search(const _node* node, uint64_t key, int inclusive)
+{
+    if (_choco_cpu_features() & _CHOCO_CPU_AVX2) {
+        return _count_avx2(node->keys, node->count, key, inclusive);
+    }
+    return _count_scalar(node->keys, node->count, key, inclusive);
+}
+
+static void _pad(_node* node)
+{
+    for (size_t i = node->count; i < _KEYS; i++) {
+        node->keys[i] = _NO_KEY;
+    }
+}
+
+static _node* _new_node(_tree* tree, int leaf)
+{
+    _node* node = tree->allocator.allocate(&tree->allocator, tree->pool.block_size);
+    if (node == NULL) {
+        return NULL;
+    }
+
+    node->count = 0;
+    node->leaf = leaf;
+    node->next = NULL;
+    _pad(node);
+    return node;
+}
+
+static void _free_node(_tree* tree, _node* node)
+{
+    if (node != NULL) {
+        tree->allocator.deallocate(&tree->allocator, node);
+    }
+}
+
+static _node* _find_leaf(const _tree* tree, uint64_t key)
+{
+    _node* node = tree->root;
+    while (!node->leaf) {
+        node = node->children[_search(node, key, 1)];
+    }
+    return node;
+}
+
+// Inserts at `index` in a leaf that has room.
+static void _leaf_insert_at(const _tree* tree, _node* leaf, size_t index, uint64_t key, const void* value)
+{
+    size_t moved = leaf->count - index;
+    memmove(&leaf->keys[index + 1], &leaf->keys[index], moved * sizeof(uint64_t));
+    memmove(_get_value(tree, leaf, index + 1), _get_value(tree, leaf, index), moved * tree->value_size);
+    leaf->keys[index] = key;
+    memcpy(_get_value(tree, leaf, index), value, tree->value_size);
+    leaf->count++;
+}
+
+static _result _insert_leaf(_tree* tree, _node* leaf, uint64_t key, const void* value, _split* split)
+{
+    size_t index = _search(leaf, key, 0);
+    if (index < leaf->count && leaf->keys[index] == key) {
+        memcpy(_get_value(tree, leaf, index), value, tree->value_size);
+        return _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    if (leaf->count < _KEYS) {
+        _leaf_insert_at(tree, leaf, index, key, value);
+        tree->length++;
+        return _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    _node* right = _new_node(tree, 1);
+    if (right == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    // Appending past the last leaf starts a new one instead of halving, so that increasing keys
+    // leave full leaves behind.
+    size_t half = index == _KEYS && leaf->next == NULL ? _KEYS : _KEYS / 2;
+    size_t moved = _KEYS - half;
+    memcpy(right->keys, &leaf->keys[half], moved * sizeof(uint64_t));
+    memcpy(_get_value(tree, right, 0), _get_value(tree, leaf, half), moved * tree->value_size);
+    right->count = (uint32_t)moved;
+    leaf->count = (uint32_t)half;
+    _pad(leaf);
+
+    right->next = leaf->next;
+    leaf->next = right;
+
+    if (index < half) {
+        _leaf_insert_at(tree, leaf, index, key, value);
+    } else {
+        _leaf_insert_at(tree, right, index - half, key, value);
+    }
+
+    tree->length++;
+    *split = (_split) { .key = right->keys[0], .right = right };
+    return _CHOCO_ARRAYLIST_RESULT_YES;
+}
+
+static _result _insert(_tree* tree, _node* node, uint64_t key, const void* value, _split* split);
+
+static _result _insert_inner(_tree* tree, _node* node, uint64_t key, const void* value, _split* split)
+{
+    // The sibling of a full node is taken before going down, since running out of memory after
+    // the child split would lose its right half.
+    _node* spare = NULL;
+    if (node->count == _INNER_KEYS) {
+        spare = _new_node(tree, 0);
+        if (spare == NULL) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+    }
+
+    size_t index = _search(node, key, 1);
+    _split child;
+    _result result = _insert(tree, node->children[index], key, value, &child);
+    if (result != _CHOCO_ARRAYLIST_RESULT_YES) {
+        _free_node(tree, spare);
+        return result;
+    }
+
+    size_t count = node->count;
+    if (spare == NULL) {
+        memmove(&node->keys[index + 1], &node->keys[index], (count - index) * sizeof(uint64_t));
+        memmove(&node->children[index + 2], &node->children[index + 1], (count - index) * sizeof(_node*));
+        node->keys[index] = child.key;
+        node->children[index + 1] = child.right;
+        node->count++;
+        return _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    uint64_t keys[_KEYS];
+    _node* children[_KEYS + 1];
+    memcpy(keys, node->keys, index * sizeof(uint64_t));
+    memcpy(&keys[index + 1], &node->keys[index], (count - index) * sizeof(uint64_t));
+    memcpy(children, node->children, (index + 1) * sizeof(_node*));
+    memcpy(&children[index + 2], &node->children[index + 1], (count - index) * sizeof(_node*));
+    keys[index] = child.key;
+    children[index + 1] = child.right;
+
+    // The middle key moves up; the keys on each side of it stay with their children.
+    size_t half = _KEYS / 2;
+    memcpy(node->keys, keys, half * sizeof(uint64_t));
+    memcpy(node->children, children, (half + 1) * sizeof(_node*));
+    node->count = (uint32_t)half;
+    _pad(node);
+
+    memcpy(spare->keys, &keys[half + 1], (_KEYS - half - 1) * sizeof(uint64_t));
+    memcpy(spare->children, &children[half + 1], (_KEYS - half) * sizeof(_node*));
+    spare->count = (uint32_t)(_KEYS - half - 1);
+
+    *split = (_split) { .key = keys[half], .right = spare };
+    return _CHOCO_ARRAYLIST_RESULT_YES;
+}
+
+// OK when `node` took the entry, YES when it split into `split`, ERROR when out of memory.
+static _result _insert(_tree* tree, _node* node, uint64_t key, const void* value, _split* split)
+{
+    if (node->leaf) {
+        return _insert_leaf(tree, node, key, value, split);
+    }
+    return _insert_inner(tree, node, key, value, split);
+}
+
+// Moves past the empty leaves that erase can leave behind.
+static void _settle(_cursor* cursor)
+{
+    const _node* leaf = cursor->leaf;
+    while (leaf != NULL && cursor->index >= leaf->count) {
+        leaf = leaf->next;
+        cursor->index = 0;
+    }
+    cursor->leaf = leaf;
+}
+
+static uint64_t _key_at(_choco_arraylist arrlist, size_t index, size_t key_offset)
+{
+    uint64_t key;
+    memcpy(&key, (const char*)_choco_arraylist_at(arrlist, index) + key_offset, sizeof(key));
+    return key;
+}
+
+_tree* _choco_bptree_create(_allocator allocator, size_t value_size)
+{
+    if (!_is_allocator_valid(allocator) || value_size == 0 || value_size > (SIZE_MAX - _VALUES_OFFSET) / _KEYS) {
+        return NULL;
+    }
+
+    _tree* tree = allocator.allocate(&allocator, sizeof(_tree));
+    if (tree == NULL) {
+        return NULL;
+    }
+
+    size_t leaf_size = _VALUES_OFFSET + _KEYS * value_size;
+    _choco_arraylist_pool_init(&tree->pool, allocator, leaf_size > sizeof(_node) ? leaf_size : sizeof(_node), _SLAB_BLOCKS);
+    tree->allocator = _choco_arraylist_pool_allocator(&tree->pool);
+    tree->value_size = value_size;
+    tree->length = 0;
+    tree->height = 1;
+
+    tree->root = _new_node(tree, 1);
+    if (tree->root == NULL) {
+        _choco_bptree_destroy(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+_result _choco_bptree_destroy(_tree* tree)
+{
+    if (tree == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _allocator allocator = tree->pool.parent;
+    _choco_arraylist_pool_release(&tree->pool);
+    allocator.deallocate(&allocator, tree);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_tree* _choco_bptree_build(_allocator allocator, _choco_arraylist arrlist, size_t key_offset)
+{
+    if (arrlist == NULL) {
+        return NULL;
+    }
+
+    size_t size = _choco_arraylist_element_size(arrlist);
+    size_t length = _choco_arraylist_length(arrlist);
+    if (key_offset > size || size - key_offset < sizeof(uint64_t)) {
+        return NULL;
+    }
+
+    for (size_t i = 1; i < length; i++) {
+        if (_key_at(arrlist, i - 1, key_offset) >= _key_at(arrlist, i, key_offset)) {
+            return NULL;
+        }
+    }
+
+    _tree* tree = _choco_bptree_create(allocator, size);
+    if (tree == NULL || length == 0) {
+        return tree;
+    }
+
+    size_t count = (length + _KEYS - 1) / _KEYS;
+    _choco_arraylist level = _choco_arraylist_create(allocator, sizeof(_entry), count);
+    level = _choco_arraylist_add_n(level, count);
+    if (_choco_arraylist_length(level) != count) {
+        _choco_arraylist_destroy(level);
+        _choco_bptree_destroy(tree);
+        return NULL;
+    }
+
+    // Leaves are filled completely, then each level above takes the next one by runs of _KEYS
+    // nodes. A level is written over the one below, which it reads ahead of.
+    _entry* entries = (_entry*)level;
+    _node* previous = NULL;
+    for (size_t i = 0; i < count; i++) {
+        _node* leaf = i == 0 ? tree->root : _new_node(tree, 1);
+        if (leaf == NULL) {
+            _choco_arraylist_destroy(level);
+            _choco_bptree_destroy(tree);
+            return NULL;
+        }
+
+        size_t first = i * _KEYS;
+        size_t keys = _min(_KEYS, length - first);
+        for (size_t j = 0; j < keys; j++) {
+            leaf->keys[j] = _key_at(arrlist, first + j, key_offset);
+        }
+        memcpy(_get_value(tree, leaf, 0), _choco_arraylist_at(arrlist, first), keys * size);
+        leaf->count = (uint32_t)keys;
+
+        if (previous != NULL) {
+            previous->next = leaf;
+        }
+        previous = leaf;
+        entries[i] = (_entry) { .key = leaf->keys[0], .node = leaf };
+    }
+
+    while (count > 1) {
+        size_t parents = (count + _KEYS - 1) / _KEYS;
+        for (size_t p = 0; p < parents; p++) {
+            _node* node = _new_node(tree, 0);
+            if (node == NULL) {
+                _choco_arraylist_destroy(level);
+                _choco_bptree_destroy(tree);
+                return NULL;
+            }
+
+            size_t first = p * _KEYS;
+            size_t children = _min(_KEYS, count - first);
+            for (size_t c = 0; c < children; c++) {
+                node->children[c] = entries[first + c].node;
+                if (c > 0) {
+                    node->keys[c - 1] = entries[first + c].key;
+                }
+            }
+            node->count = (uint32_t)(children - 1);
+            entries[p] = (_entry) { .key = entries[first].key, .node = node };
+        }
+
+        count = parents;
+        tree->height++;
+    }
+
+    tree->root = entries[0].node;
+    tree->length = length;
+    _choco_arraylist_destroy(level);
+    return tree;
+}
+
+_result _choco_bptree_insert(_tree* tree, uint64_t key, const void* value)
+{
+    if (tree == NULL || value == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    // Same as for inner nodes: a full root gets its new parent up front.
+    _node* root = tree->root;
+    _node* spare = NULL;
+    if (root->count == (root->leaf ? _KEYS : _INNER_KEYS)) {
+        spare = _new_node(tree, 0);
+        if (spare == NULL) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+    }
+
+    _split split;
+    _result result = _insert(tree, root, key, value, &split);
+    if (result != _CHOCO_ARRAYLIST_RESULT_YES) {
+        _free_node(tree, spare);
+        return result;
+    }
+
+    spare->keys[0] = split.key;
+    spare->children[0] = root;
+    spare->children[1] = split.right;
+    spare->count = 1;
+    tree->root = spare;
+    tree->height++;
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_bptree_erase(_tree* tree, uint64_t key)
+{
+    if (tree == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _node* leaf = _find_leaf(tree, key);
+    size_t index = _search(leaf, key, 0);
+    if (index >= leaf->count || leaf->keys[index] != key) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t moved = leaf->count - index - 1;
+    memmove(&leaf->keys[index], &leaf->keys[index + 1], moved * sizeof(uint64_t));
+    memmove(_get_value(tree, leaf, index), _get_value(tree, leaf, index + 1), moved * tree->value_size);
+    leaf->count--;
+    leaf->keys[leaf->count] = _NO_KEY;
+    tree->length--;
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+void* _choco_bptree_find(const _tree* tree, uint64_t key)
+{
+    if (tree == NULL) {
+        return NULL;
+    }
+
+    _node* leaf = _find_leaf(tree, key);
+    size_t index = _search(leaf, key, 0);
+    if (index >= leaf->count || leaf->keys[index] != key) {
+        return NULL;
+    }
+    return _get_value(tree, leaf, index);
+}
+
+_cursor _choco_bptree_lower_bound(const _tree* tree, uint64_t key)
+{
+    _cursor cursor = { .tree = tree, .leaf = NULL, .index = 0 };
+    if (tree == NULL) {
+        return cursor;
+    }
+
+    _node* leaf = _find_leaf(tree, key);
+    cursor.leaf = leaf;
+    cursor.index = _search(leaf, key, 0);
+    _settle(&cursor);
+    return cursor;
+}
+
+_result _choco_bptree_cursor_valid(const _cursor* cursor)
+{
+    if (cursor == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    return cursor->leaf != NULL ? _CHOCO_ARRAYLIST_RESULT_YES : _CHOCO_ARRAYLIST_RESULT_NO;
+}
+
+_result _choco_bptree_cursor_next(_cursor* cursor)
+{
+    if (cursor == NULL || cursor->leaf == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    cursor->index++;
+    _settle(cursor);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+uint64_t _choco_bptree_cursor_key(const _cursor* cursor)
+{
+    if (cursor == NULL || cursor->leaf == NULL) {
+        return 0;
+    }
+
+    return ((const _node*)cursor->leaf)->keys[cursor->index];
+}
+
+void* _choco_bptree_cursor_value(const _cursor* cursor)
+{
+    if (cursor == NULL || cursor->leaf == NULL) {
+        return NULL;
+    }
+
+    return _get_value(cursor->tree, cursor->leaf, cursor->index);
+}
+
+size_t _choco_bptree_length(const _tree* tree)
+{
+    if (tree == NULL) {
+        return 0;
+    }
+
+    return tree->length;
+}
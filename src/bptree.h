@@ -0,0 +1,64 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include "pool_allocator.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Keys held by a node. Inner nodes use one key less, so that their children fit too.
+#define _CHOCO_BPTREE_KEYS (32)
+
+// Ordered map from 64 bit keys to values of `value_size` bytes. Nodes come from `pool`, whose
+// blocks hold either an inner node or a leaf, rounded up to whole cache lines. Leaves are
+// chained in key order for range scans.
+typedef struct _choco_bptree {
+    _choco_arraylist_allocator allocator;
+    _choco_arraylist_pool pool;
+    void* root;
+    size_t value_size;
+    size_t length;
+    size_t height;
+} _choco_bptree;
+
+// Position of an entry in the leaves; `leaf` is NULL past the last entry.
+typedef struct _choco_bptree_cursor {
+    const _choco_bptree* tree;
+    const void* leaf;
+    size_t index;
+} _choco_bptree_cursor;
+
+_choco_bptree* _choco_bptree_create(_choco_arraylist_allocator allocator, size_t value_size);
+_choco_arraylist_result _choco_bptree_destroy(_choco_bptree* tree);
+
+// Builds a tree from a list sorted by strictly increasing keys, filling the leaves in one
+// pass. The key of each element is the `uint64_t` at `key_offset`, and its value is the whole
+// element. Returns NULL when the list is not sorted.
+_choco_bptree* _choco_bptree_build(_choco_arraylist_allocator allocator, _choco_arraylist arrlist, size_t key_offset);
+
+// Copies `value` into the entry of `key`, adding the entry when it is not there yet.
+_choco_arraylist_result _choco_bptree_insert(_choco_bptree* tree, uint64_t key, const void* value);
+
+// Leaves are not merged after an erase, so a tree that shrinks keeps its nodes until destroyed.
+_choco_arraylist_result _choco_bptree_erase(_choco_bptree* tree, uint64_t key);
+
+// Value of `key`, or NULL when it is not there. The pointer is valid until the next insert.
+void* _choco_bptree_find(const _choco_bptree* tree, uint64_t key);
+
+// Cursor on the first entry whose key is not less than `key`.
+_choco_bptree_cursor _choco_bptree_lower_bound(const _choco_bptree* tree, uint64_t key);
+_choco_arraylist_result _choco_bptree_cursor_valid(const _choco_bptree_cursor* cursor);
+_choco_arraylist_result _choco_bptree_cursor_next(_choco_bptree_cursor* cursor);
+uint64_t _choco_bptree_cursor_key(const _choco_bptree_cursor* cursor);
+void* _choco_bptree_cursor_value(const _choco_bptree_cursor* cursor);
+
+size_t _choco_bptree_length(const _choco_bptree* tree);
+
+#ifdef __cplusplus
+}
+#endif
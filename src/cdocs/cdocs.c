@@ -3,37 +3,131 @@
 */
 
 #include "cdocs.h"
-#include <stdio.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
-#include <assert.h>
+#include <unistd.h>
+
+#define _CDOCS_FNV_OFFSET UINT64_C(0xcbf29ce484222325)
+#define _CDOCS_FNV_PRIME UINT64_C(0x100000001b3)
+
+typedef struct _cdocs_buffer {
+    char* data;
+    size_t length;
+    size_t capacity;
+} _cdocs_buffer;
+
+static void _cdocs_append(_cdocs_buffer* buffer, const char* text) {
+    if(text == NULL) {
+        return;
+    }
+
+    size_t length = strlen(text);
+    if(buffer->length + length > buffer->capacity) {
+        size_t capacity = buffer->capacity * 2;
+        if(capacity < buffer->length + length) {
+            capacity = buffer->length + length;
+        }
+        buffer->data = realloc(buffer->data, capacity);
+        assert(buffer->data != NULL);
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->length, text, length);
+    buffer->length += length;
+}
+
+static uint64_t _cdocs_hash(uint64_t hash, const char* data, size_t length) {
+    for(size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)data[i]) * _CDOCS_FNV_PRIME;
+    }
+    return hash;
+}
 
-static void _cdocs_generate_function_doc(FILE* file, _cdocs_fn_struct* function) {
-    fprintf(file, "---\n");
-    fprintf(file, "%s `%s`\n", "##", function->function.name);
-    fprintf(file, "%s Description\n%s\n", "###", function->function.description);
-    fprintf(file, "%s Returns: `%s`\n%s\n", "###", function->returns.returns, function->returns.description);
-    fprintf(file, "%s Parameters\n", "###");
+// Compares the FNV-1a hash of the file with the one of the buffer, reading the file in chunks.
+static int _cdocs_is_unchanged(const char* filename, const _cdocs_buffer* buffer) {
+    int file = open(filename, O_RDONLY);
+    if(file < 0) {
+        return 0;
+    }
 
-    _cdocs_fn_p_struct* it = function->parameters;
-    while(it->signature != NULL) {
-        fprintf(file, "`%s` : %s\n", it->signature, it->description);
-        it++;
+    char chunk[16384];
+    uint64_t hash = _CDOCS_FNV_OFFSET;
+    size_t length = 0;
+    ssize_t count;
+    while((count = read(file, chunk, sizeof(chunk))) > 0) {
+        hash = _cdocs_hash(hash, chunk, (size_t)count);
+        length += (size_t)count;
     }
-    fprintf(file, "\n");
+    close(file);
+
+    return count == 0 && length == buffer->length
+        && hash == _cdocs_hash(_CDOCS_FNV_OFFSET, buffer->data, buffer->length);
 }
 
-void _cdocs_generate_documentation_x(const char* filename, const char* subject, size_t size, _cdocs_fn_struct* functions) {
+static void _cdocs_generate_function_doc(_cdocs_buffer* buffer, const _cdocs_fn_struct* function) {
+    _cdocs_append(buffer, "---\n## `");
+    _cdocs_append(buffer, function->function.name);
+    _cdocs_append(buffer, "`\n### Description\n");
+    _cdocs_append(buffer, function->function.description);
+    _cdocs_append(buffer, "\n### Returns: `");
+    _cdocs_append(buffer, function->returns.returns);
+    _cdocs_append(buffer, "`\n");
+    _cdocs_append(buffer, function->returns.description);
+    _cdocs_append(buffer, "\n### Parameters\n");
+
+    for(size_t i = 0; i < function->parameter_count; i++) {
+        _cdocs_append(buffer, "`");
+        _cdocs_append(buffer, function->parameters[i].signature);
+        _cdocs_append(buffer, "` : ");
+        _cdocs_append(buffer, function->parameters[i].description);
+        _cdocs_append(buffer, "\n");
+    }
+    _cdocs_append(buffer, "\n");
+}
+
+int _cdocs_generate_documentation_n(const char* filename, const _cdocs_subject_struct* subjects, size_t count) {
     assert(filename != NULL);
-    assert(subject != NULL);
-    assert(functions != NULL);
+    assert(subjects != NULL);
+
+    _cdocs_buffer buffer = { .data = NULL, .length = 0, .capacity = 0 };
+    _cdocs_append(&buffer, "<!-- Generated by cdocs. -->\n");
+    for(size_t s = 0; s < count; s++) {
+        assert(subjects[s].subject != NULL);
+        assert(subjects[s].functions != NULL);
 
-    FILE* document = fopen(filename, "w+");
-    assert(document != NULL);
-    fprintf(document, "<!-- Generated by cdocs. -->\n");
-    fprintf(document, "%s %s\n\n", "#", subject);
-    for(size_t i = 0; i < size; i++) {
-        _cdocs_generate_function_doc(document, &functions[i]);
+        _cdocs_append(&buffer, "# ");
+        _cdocs_append(&buffer, subjects[s].subject);
+        _cdocs_append(&buffer, "\n\n");
+        for(size_t i = 0; i < subjects[s].size; i++) {
+            _cdocs_generate_function_doc(&buffer, &subjects[s].functions[i]);
+        }
     }
-    fclose(document);
+
+    // Leaving an unchanged file alone keeps its timestamp, so nothing depending on it rebuilds.
+    if(_cdocs_is_unchanged(filename, &buffer)) {
+        free(buffer.data);
+        return 0;
+    }
+
+    int document = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    assert(document >= 0);
+    for(size_t written = 0; written < buffer.length;) {
+        ssize_t result = write(document, buffer.data + written, buffer.length - written);
+        assert(result > 0);
+        if(result <= 0) {
+            break;
+        }
+        written += (size_t)result;
+    }
+    close(document);
+    free(buffer.data);
+    return 1;
+}
+
+int _cdocs_generate_documentation_x(const char* filename, const char* subject, size_t size, const _cdocs_fn_struct* functions) {
+    _cdocs_subject_struct single = { .subject = subject, .size = size, .functions = functions };
+    return _cdocs_generate_documentation_n(filename, &single, 1);
 }
@@ -10,7 +10,6 @@ typedef struct _cdocs_fn_r_struct {
     const char* description;
 } _cdocs_fn_r_struct;
 
-#define _cdocs_ending_p (_cdocs_fn_p_struct){.signature = NULL, .description = NULL}
 typedef struct _cdocs_fn_p_struct {
     const char* signature;
     const char* description;
@@ -21,14 +20,24 @@ typedef struct _cdocs_fn_f_struct {
     const char* description;
 } _cdocs_fn_f_struct;
 
-#define _cdocs_fn_p_count (20)
 typedef struct _cdocs_fn_struct {
     _cdocs_fn_f_struct function;
     _cdocs_fn_r_struct returns;
-    _cdocs_fn_p_struct parameters[_cdocs_fn_p_count + 1]; // +1: array must end with _cdocs_ending_p.
+    const _cdocs_fn_p_struct* parameters;
+    size_t parameter_count;
 } _cdocs_fn_struct;
 
-void _cdocs_generate_documentation_x(const char* filename, const char* subject, size_t size, _cdocs_fn_struct* functions);
+typedef struct _cdocs_subject_struct {
+    const char* subject;
+    size_t size;
+    const _cdocs_fn_struct* functions;
+} _cdocs_subject_struct;
+
+// Renders every subject into one buffer, and writes it to `filename` with a single `write`
+// unless the file already holds the same content. Returns 1 when the file was written, 0 when
+// it was left as is.
+int _cdocs_generate_documentation_n(const char* filename, const _cdocs_subject_struct* subjects, size_t count);
+int _cdocs_generate_documentation_x(const char* filename, const char* subject, size_t size, const _cdocs_fn_struct* functions);
 
 #define _cdocs_fn_p(_sig, _desc) (_cdocs_fn_p_struct) {.signature = #_sig, .description = _desc}
 
@@ -36,7 +45,18 @@ void _cdocs_generate_documentation_x(const char* filename, const char* subject,
 
 #define _cdocs_fn_f(_name, _desc) (_cdocs_fn_f_struct) {.name = #_name, .description = _desc}
 
-#define _cdocs_fn(f, r, ...) (_cdocs_fn_struct){.function = f, .returns = r, .parameters = {__VA_ARGS__, _cdocs_ending_p}}
+// The parameters are kept in an array sized to fit them, which lives as long as the scope of
+// the macro.
+#define _cdocs_fn(f, r, ...)                                                                           \
+    (_cdocs_fn_struct) {                                                                               \
+        .function = f,                                                                                 \
+        .returns = r,                                                                                  \
+        .parameters = (const _cdocs_fn_p_struct[]) { __VA_ARGS__ },                                    \
+        .parameter_count = sizeof((_cdocs_fn_p_struct[]) { __VA_ARGS__ }) / sizeof(_cdocs_fn_p_struct) \
+    }
+
+#define _cdocs_subject(_subject, _functions) \
+    (_cdocs_subject_struct) {.subject = _subject, .size = sizeof(_functions) / sizeof(_functions[0]), .functions = _functions}
 
 #define _cdocs_generate_documentation(subject, functions) \
     _cdocs_generate_documentation_x(__FILE__ ".md", subject, sizeof(functions) / sizeof(functions[0]), functions)
@@ -0,0 +1,46 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "cpu.h"
+
+// Features are detected once; `_choco_cpu_restrict` can only mask them, which lets tests and
+// benchmarks force the scalar kernels on a machine that has the vector ones.
+static unsigned _detected = 0;
+static unsigned _allowed = ~0u;
+static int _is_detected = 0;
+
+static unsigned _detect(void)
+{
+    unsigned features = 0;
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("popcnt")) {
+        features |= _CHOCO_CPU_POPCNT;
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        features |= _CHOCO_CPU_AVX2;
+    }
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        features |= _CHOCO_CPU_AVX512;
+    }
+
+    return features;
+}
+
+unsigned _choco_cpu_features(void)
+{
+    if (!__atomic_load_n(&_is_detected, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&_detected, _detect(), __ATOMIC_RELAXED);
+        __atomic_store_n(&_is_detected, 1, __ATOMIC_RELEASE);
+    }
+
+    return __atomic_load_n(&_detected, __ATOMIC_RELAXED) & __atomic_load_n(&_allowed, __ATOMIC_RELAXED);
+}
+
+void _choco_cpu_restrict(unsigned features)
+{
+    __atomic_store_n(&_allowed, features, __ATOMIC_RELAXED);
+}
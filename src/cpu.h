@@ -0,0 +1,22 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum _choco_cpu_feature {
+    _CHOCO_CPU_POPCNT = 1 << 0,
+    _CHOCO_CPU_AVX2 = 1 << 1,
+    _CHOCO_CPU_AVX512 = 1 << 2,
+} _choco_cpu_feature;
+
+unsigned _choco_cpu_features(void);
+void _choco_cpu_restrict(unsigned features);
+
+#ifdef __cplusplus
+}
+#endif
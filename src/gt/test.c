@@ -2,16 +2,44 @@
     Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
 */
 
+#define _GNU_SOURCE
 #include "test.h"
+#include <signal.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
 
 #define COLOR_F(fore, text) "\x1b[" #fore "m" text "\x1b[0m "
 #define COLOR_FB(fore, back, text) "\x1b[" #fore ";" #back "m" text "\x1b[0m "
 
+#define _GT_EXIT_PASSED (0)
+#define _GT_EXIT_FAILED (1)
+#define _GT_EXIT_SILENT (2)
+
+static struct _gt_registry {
+    _gt_entry_t* entries;
+    size_t count;
+    size_t allocated;
+} _gt_registry = { 0 };
+
+static struct _gt_state {
+    int passed;
+    int failed;
+} _gt_state = { 0 };
+
+typedef struct _gt_job {
+    pid_t pid;
+    _gt_entry_t* entry;
+    FILE* output;
+    struct timespec start;
+} _gt_job_t;
+
 // - - - - - - - - -
 
 void _gt_bin_op(const char* op, const _gt_str_t param1, const _gt_str_t param2, const _gt_str_t expr1, const _gt_str_t expr2, _gt_info_t info) {
+    _gt_state.failed = 1;
     printf(COLOR_FB(97, 41, "%-50s") "has failed !\n", info.func);
     printf(COLOR_F(91, "Line %u: ") "\n", info.line);
     printf(COLOR_F(91, "%s %s %s") "\n", expr1, op, expr2);
@@ -21,5 +49,215 @@ void _gt_bin_op(const char* op, const _gt_str_t param1, const _gt_str_t param2,
 // - - - - - - - - -
 
 void _gt_success(const char* func) {
+    _gt_state.passed = 1;
     printf(COLOR_FB(30, 42, "%-50s") "has passed !\n", func);
-}
\ No newline at end of file
+}
+
+// - - - - - - - - -
+
+void _gt_register(const char* name, _gt_fn_t fn) {
+    if (_gt_registry.count >= _gt_registry.allocated) {
+        size_t allocated = (_gt_registry.allocated + 1) * 2;
+        _gt_entry_t* entries = realloc(_gt_registry.entries, allocated * sizeof(_gt_entry_t));
+        if (entries == NULL) {
+            fprintf(stderr, "gt: cannot register '%s'\n", name);
+            return;
+        }
+        _gt_registry.entries = entries;
+        _gt_registry.allocated = allocated;
+    }
+
+    _gt_registry.entries[_gt_registry.count++] = (_gt_entry_t) { .name = name, .fn = fn };
+}
+
+// - - - - - - - - -
+
+static double _gt_elapsed_ms(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) * 1e3 + (now.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+static int _gt_matches(const char* name, char** filters, size_t count) {
+    if (count == 0) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (strstr(name, filters[i]) != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void _gt_usage(const char* program) {
+    printf("usage: %s [-j jobs] [-l] [filter...]\n", program);
+    printf("  -j jobs  number of worker processes (default: online cpus)\n");
+    printf("  -l       list matching tests without running them\n");
+    printf("  filter   runs tests whose name contains any of the filters\n");
+}
+
+// Runs the test in the forked child. Output goes to the job's file so that workers never
+// interleave; it is line buffered so that a crashing test still leaves its output behind.
+static void _gt_run_child(_gt_job_t* job) {
+    int fd = fileno(job->output);
+    dup2(fd, STDOUT_FILENO);
+    dup2(fd, STDERR_FILENO);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    _gt_state = (struct _gt_state) { 0 };
+    job->entry->fn();
+    fflush(stdout);
+
+    if (_gt_state.failed) {
+        _exit(_GT_EXIT_FAILED);
+    }
+    _exit(_gt_state.passed ? _GT_EXIT_PASSED : _GT_EXIT_SILENT);
+}
+
+static int _gt_spawn(_gt_job_t* job, _gt_entry_t* entry) {
+    *job = (_gt_job_t) { .pid = -1, .entry = entry, .output = tmpfile() };
+    if (job->output == NULL) {
+        return 0;
+    }
+
+    fflush(stdout);
+    clock_gettime(CLOCK_MONOTONIC, &job->start);
+    job->pid = fork();
+    if (job->pid < 0) {
+        fclose(job->output);
+        return 0;
+    }
+
+    if (job->pid == 0) {
+        _gt_run_child(job);
+    }
+    return 1;
+}
+
+// Prints the buffered output of a finished job followed by its verdict and wall time.
+// Returns 1 if the test passed.
+static int _gt_report(_gt_job_t* job, int status) {
+    double elapsed = _gt_elapsed_ms(job->start);
+    char buffer[4096];
+    size_t read;
+
+    rewind(job->output);
+    while ((read = fread(buffer, 1, sizeof(buffer), job->output)) > 0) {
+        fwrite(buffer, 1, read, stdout);
+    }
+    fclose(job->output);
+
+    int passed = 0;
+    if (WIFSIGNALED(status)) {
+        printf(COLOR_FB(97, 41, "%-50s") "has crashed ! (%s)\n", job->entry->name, strsignal(WTERMSIG(status)));
+    } else if (WEXITSTATUS(status) == _GT_EXIT_SILENT) {
+        printf(COLOR_FB(97, 41, "%-50s") "has not reported a result !\n", job->entry->name);
+    } else {
+        passed = WEXITSTATUS(status) == _GT_EXIT_PASSED;
+    }
+
+    printf(COLOR_F(90, "%-50s %10.3f ms") "\n", job->entry->name, elapsed);
+    fflush(stdout);
+    return passed;
+}
+
+int _gt_main(int argc, char** argv) {
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    int list_only = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:lh")) != -1) {
+        switch (opt) {
+        case 'j':
+            jobs = strtol(optarg, NULL, 10);
+            break;
+        case 'l':
+            list_only = 1;
+            break;
+        default:
+            _gt_usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    if (jobs < 1) {
+        jobs = 1;
+    }
+
+    char** filters = &argv[optind];
+    size_t filter_count = argc - optind;
+    _gt_entry_t** selected = malloc((_gt_registry.count + 1) * sizeof(_gt_entry_t*));
+    _gt_job_t* running = calloc(jobs, sizeof(_gt_job_t));
+    if (selected == NULL || running == NULL) {
+        free(selected);
+        free(running);
+        return 2;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < _gt_registry.count; i++) {
+        if (_gt_matches(_gt_registry.entries[i].name, filters, filter_count)) {
+            selected[count++] = &_gt_registry.entries[i];
+        }
+    }
+
+    if (list_only) {
+        for (size_t i = 0; i < count; i++) {
+            printf("%s\n", selected[i]->name);
+        }
+        free(selected);
+        free(running);
+        return 0;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    size_t next = 0, active = 0, passed = 0, failed = 0;
+    while (next < count || active > 0) {
+        for (long slot = 0; slot < jobs && next < count; slot++) {
+            if (running[slot].entry != NULL) {
+                continue;
+            }
+
+            if (_gt_spawn(&running[slot], selected[next])) {
+                active++;
+            } else {
+                printf(COLOR_FB(97, 41, "%-50s") "could not be started !\n", selected[next]->name);
+                running[slot].entry = NULL;
+                failed++;
+            }
+            next++;
+        }
+
+        if (active == 0) {
+            continue;
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            break;
+        }
+
+        for (long slot = 0; slot < jobs; slot++) {
+            if (running[slot].entry != NULL && running[slot].pid == pid) {
+                if (_gt_report(&running[slot], status)) {
+                    passed++;
+                } else {
+                    failed++;
+                }
+                running[slot].entry = NULL;
+                active--;
+                break;
+            }
+        }
+    }
+
+    printf("%zu passed, %zu failed, %.3f ms\n", passed, failed, _gt_elapsed_ms(start));
+    free(selected);
+    free(running);
+    return failed == 0 ? 0 : 1;
+}
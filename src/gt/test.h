@@ -6,6 +6,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef const char *_gt_str_t;
 
 typedef struct _gt_info
@@ -19,9 +23,34 @@ void _gt_bin_op(const char *op, const _gt_str_t param1, const _gt_str_t param2,
 
 void _gt_success(const char *func);
 
+typedef void (*_gt_fn_t)(void);
+
+typedef struct _gt_entry
+{
+    const char *name;
+    _gt_fn_t fn;
+} _gt_entry_t;
+
+// Adds a test to the registry. Called by the constructor generated by `_gt_test`.
+void _gt_register(const char *name, _gt_fn_t fn);
+
+// Runs every registered test matching the filters given on the command line, each in its
+// own forked process, on up to `-j N` workers. Returns the process exit code.
+int _gt_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
 #define _gt_passed() _gt_success(__func__);
 
-#define _gt_test(fn, opt_case) void test_##fn##_##opt_case(void)
+#define _gt_test(fn, opt_case)                                                    \
+    void test_##fn##_##opt_case(void);                                            \
+    __attribute__((constructor)) static void _gt_register_##fn##_##opt_case(void) \
+    {                                                                             \
+        _gt_register("test_" #fn "_" #opt_case, test_##fn##_##opt_case);          \
+    }                                                                             \
+    void test_##fn##_##opt_case(void)
 
 #define _gt_run(fn, opt_case) test_##fn##_##opt_case()
 
@@ -31,7 +60,7 @@ void _gt_success(const char *func);
 #define _gt_test_int_bin_op(n1, op, n2)                            \
     {                                                              \
         long _n1 = n1, _n2 = n2;                                   \
-        if (!(n1 op n2))                                           \
+        if (!(_n1 op _n2))                                         \
         {                                                          \
             char _nb1[20], _nb2[20];                               \
             sprintf(_nb1, "%li", _n1);                             \
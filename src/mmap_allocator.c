@@ -0,0 +1,246 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#define _GNU_SOURCE
+#include "mmap_allocator.h"
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+typedef _choco_arraylist_allocator _allocator;
+typedef _choco_arraylist_mmap_options _options;
+
+#define _HUGE_PAGE_SIZE ((size_t)2 << 20)
+#define _MPOL_BIND (2)
+#define _FLAG_MAPPED (1u << 0)
+#define _FLAG_HUGETLB (1u << 1)
+
+#define _round_up(value, granule) \
+    (((value) + (granule) - 1) / (granule) * (granule))
+
+#define _get_prefix(ptr) \
+    (((_prefix*)ptr) - 1)
+
+// Every block starts with its length and origin, since `deallocate` only gets the pointer.
+typedef struct _prefix {
+    size_t length;
+    size_t flags;
+} _prefix;
+
+static const _options _defaults = {
+    .threshold = _HUGE_PAGE_SIZE,
+    .huge_pages = 1,
+    .populate = 0,
+    .numa_node = -1,
+};
+
+static const _options* _get_options(void* self)
+{
+    const _options* options = ((_allocator*)self)->context;
+    return options != NULL ? options : &_defaults;
+}
+
+static size_t _page_size(void)
+{
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static void _bind(void* block, size_t length, int node)
+{
+    if (node < 0 || node >= (int)(8 * sizeof(unsigned long))) {
+        return;
+    }
+
+    unsigned long mask = 1ul << node;
+    syscall(SYS_mbind, block, length, _MPOL_BIND, &mask, 8 * sizeof(unsigned long), 0);
+}
+
+static void _prefault(char* block, size_t length)
+{
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(block, length, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+
+    size_t page = _page_size();
+    for (size_t i = 0; i < length; i += page) {
+        ((volatile char*)block)[i] = 0;
+    }
+}
+
+// Transparent huge pages only back 2MB aligned ranges, so the range is over-mapped by one huge
+// page and trimmed to an aligned one.
+static char* _map_aligned(size_t length)
+{
+    size_t span = length + _HUGE_PAGE_SIZE;
+    char* raw = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return NULL;
+    }
+
+    char* block = (char*)_round_up((uintptr_t)raw, _HUGE_PAGE_SIZE);
+    if (block > raw) {
+        munmap(raw, block - raw);
+    }
+
+    size_t tail = (raw + span) - (block + length);
+    if (tail > 0) {
+        munmap(block + length, tail);
+    }
+
+    madvise(block, length, MADV_HUGEPAGE);
+    return block;
+}
+
+static _prefix* _map(const _options* options, size_t size)
+{
+    // Binding has to happen before the pages are faulted, so MAP_POPULATE is only used when
+    // there is no node to bind to.
+    int populate = options->populate && options->numa_node < 0 ? MAP_POPULATE : 0;
+    int populated = populate != 0;
+    size_t length;
+    size_t flags = _FLAG_MAPPED;
+    char* block = NULL;
+
+    if (options->huge_pages) {
+        length = _round_up(size, _HUGE_PAGE_SIZE);
+        block = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | populate, -1, 0);
+        if (block != MAP_FAILED) {
+            flags |= _FLAG_HUGETLB;
+        } else {
+            block = _map_aligned(length);
+            populated = 0;
+        }
+    } else {
+        length = _round_up(size, _page_size());
+        block = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | populate, -1, 0);
+        if (block == MAP_FAILED) {
+            block = NULL;
+        }
+    }
+
+    if (block == NULL) {
+        return NULL;
+    }
+
+    _bind(block, length, options->numa_node);
+    if (options->populate && !populated) {
+        _prefault(block, length);
+    }
+
+    _prefix* prefix = (_prefix*)block;
+    *prefix = (_prefix) { .length = length, .flags = flags };
+    return prefix;
+}
+
+static void* _mmap_alloc(void* self, size_t size)
+{
+    const _options* options = _get_options(self);
+    size_t total = sizeof(_prefix) + size;
+
+    if (total < options->threshold) {
+        _prefix* prefix = malloc(total);
+        if (prefix == NULL) {
+            return NULL;
+        }
+
+        *prefix = (_prefix) { .length = total, .flags = 0 };
+        return prefix + 1;
+    }
+
+    _prefix* prefix = _map(options, total);
+    return prefix == NULL ? NULL : prefix + 1;
+}
+
+static void _mmap_dealloc(void* self, void* ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    _prefix* prefix = _get_prefix(ptr);
+    if (prefix->flags & _FLAG_MAPPED) {
+        munmap(prefix, prefix->length);
+    } else {
+        free(prefix);
+    }
+}
+
+// Mapped blocks grow with mremap, which moves page tables instead of copying, and give memory
+// back on shrink. Heap blocks and growing hugetlb mappings fall back to allocate and copy.
+static void* _mmap_realloc(void* self, void* ptr, size_t old_size, size_t size)
+{
+    const _options* options = _get_options(self);
+    _prefix* prefix = _get_prefix(ptr);
+
+    if (!(prefix->flags & _FLAG_MAPPED)) {
+        return NULL;
+    }
+
+    size_t total = sizeof(_prefix) + size;
+
+    if (prefix->flags & _FLAG_HUGETLB) {
+        size_t length = _round_up(total, _HUGE_PAGE_SIZE);
+        if (length > prefix->length) {
+            return NULL;
+        }
+
+        if (length < prefix->length) {
+            madvise((char*)prefix + length, prefix->length - length, MADV_DONTNEED);
+        }
+        return ptr;
+    }
+
+    size_t length = _round_up(total, _page_size());
+    if (length == prefix->length) {
+        return ptr;
+    }
+
+    if (length < prefix->length) {
+        if (mremap(prefix, prefix->length, length, 0) == MAP_FAILED) {
+            madvise((char*)prefix + length, prefix->length - length, MADV_DONTNEED);
+            return ptr;
+        }
+
+        prefix->length = length;
+        return ptr;
+    }
+
+    size_t old_length = prefix->length;
+    char* moved = mremap(prefix, old_length, length, MREMAP_MAYMOVE);
+    if (moved == MAP_FAILED) {
+        return NULL;
+    }
+
+    if (options->huge_pages) {
+        madvise(moved, length, MADV_HUGEPAGE);
+    }
+
+    _bind(moved, length, options->numa_node);
+    if (options->populate) {
+        _prefault(moved + old_length, length - old_length);
+    }
+
+    prefix = (_prefix*)moved;
+    prefix->length = length;
+    return prefix + 1;
+}
+
+_options _choco_arraylist_mmap_defaults(void)
+{
+    return _defaults;
+}
+
+_allocator _choco_arraylist_mmap_allocator(const _options* options)
+{
+    _allocator allocator = {
+        .allocate = _mmap_alloc,
+        .deallocate = _mmap_dealloc,
+        .reallocate = _mmap_realloc,
+        .context = (void*)options
+    };
+    return allocator;
+}
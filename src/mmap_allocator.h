@@ -0,0 +1,27 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _choco_arraylist_mmap_options {
+    size_t threshold; // blocks smaller than this come from malloc.
+    int huge_pages; // tries MAP_HUGETLB, then madvise(MADV_HUGEPAGE).
+    int populate; // pre-faults mapped blocks.
+    int numa_node; // binds mapped blocks to a node; -1 leaves placement to the kernel.
+} _choco_arraylist_mmap_options;
+
+// Options used when NULL is given: 2MB threshold, huge pages, no pre-fault, no binding.
+_choco_arraylist_mmap_options _choco_arraylist_mmap_defaults(void);
+
+// The allocator keeps a pointer to `options`, which must outlive every list using it.
+_choco_arraylist_allocator _choco_arraylist_mmap_allocator(const _choco_arraylist_mmap_options* options);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,334 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "numeric.h"
+#include "cpu.h"
+
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+// Independent accumulators per reduction, so that consecutive vector adds do not wait on each
+// other, and counter tables per histogram, so that runs of equal bins do not either.
+#define _ACCUMULATORS (4)
+#define _TABLES (4)
+
+#define _is_list_of(arrlist, type) \
+    (arrlist != NULL && _choco_arraylist_element_size(arrlist) == sizeof(type))
+
+#define _is_writable_list_of(arrlist, type) \
+    (_is_list_of(arrlist, type) && _choco_arraylist_is_shared(arrlist) == _CHOCO_ARRAYLIST_RESULT_NO)
+
+// Lane-wise `mask ? a : b` for GCC vectors, which only have `?:` in C++.
+#define _select(mask, a, b, vector, mask_vector) \
+    ((vector)(((mask_vector)(a) & (mask)) | ((mask_vector)(b) & ~(mask))))
+
+#define _dispatch(kernel, ...)                                  \
+    (_choco_cpu_features() & _CHOCO_CPU_AVX512                  \
+            ? kernel##_avx512(__VA_ARGS__)                      \
+            : _choco_cpu_features() & _CHOCO_CPU_AVX2           \
+            ? kernel##_avx2(__VA_ARGS__)                        \
+            : kernel##_generic(__VA_ARGS__))
+
+// Every kernel is written once against GCC vectors of `width` bytes, and compiled for the
+// x86-64 baseline (16 bytes, SSE2), AVX2 (32 bytes) and AVX-512 (64 bytes). The generic build
+// falls back to scalar code on other targets.
+#define _define_kernels(suffix, type, mask_type, sum_type, isa, width, attributes)                                                           \
+    attributes static sum_type _sum_##suffix##_##isa(const type* data, size_t count)                                                         \
+    {                                                                                                                                        \
+        typedef sum_type _acc __attribute__((vector_size(width)));                                                                           \
+        typedef type _narrow __attribute__((vector_size(width / sizeof(sum_type) * sizeof(type))));                                          \
+        const size_t lanes = width / sizeof(sum_type);                                                                                       \
+        _acc acc[_ACCUMULATORS] = { { 0 } };                                                                                                 \
+        size_t i = 0;                                                                                                                        \
+                                                                                                                                             \
+        for (; i + _ACCUMULATORS * lanes <= count; i += _ACCUMULATORS * lanes) {                                                             \
+            for (size_t k = 0; k < _ACCUMULATORS; k++) {                                                                                     \
+                _narrow values;                                                                                                              \
+                memcpy(&values, data + i + k * lanes, sizeof(values));                                                                       \
+                acc[k] += __builtin_convertvector(values, _acc);                                                                             \
+            }                                                                                                                                \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        sum_type total = 0;                                                                                                                  \
+        for (size_t k = 0; k < _ACCUMULATORS; k++) {                                                                                         \
+            for (size_t lane = 0; lane < lanes; lane++) {                                                                                    \
+                total += acc[k][lane];                                                                                                       \
+            }                                                                                                                                \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        for (; i < count; i++) {                                                                                                             \
+            total += data[i];                                                                                                                \
+        }                                                                                                                                    \
+        return total;                                                                                                                        \
+    }                                                                                                                                        \
+                                                                                                                                             \
+    attributes static void _minmax_##suffix##_##isa(const type* data, size_t count, type* min, type* max)                                    \
+    {                                                                                                                                        \
+        typedef type _vector __attribute__((vector_size(width)));                                                                            \
+        typedef mask_type _mask __attribute__((vector_size(width)));                                                                         \
+        const size_t lanes = width / sizeof(type);                                                                                           \
+        _vector low = (_vector) { 0 } + data[0];                                                                                             \
+        _vector high = low;                                                                                                                  \
+        size_t i = 0;                                                                                                                        \
+                                                                                                                                             \
+        for (; i + lanes <= count; i += lanes) {                                                                                             \
+            _vector values;                                                                                                                  \
+            memcpy(&values, data + i, sizeof(values));                                                                                       \
+            low = _select(values < low, values, low, _vector, _mask);                                                                        \
+            high = _select(values > high, values, high, _vector, _mask);                                                                     \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        type lowest = data[0], highest = data[0];                                                                                            \
+        for (size_t lane = 0; lane < lanes; lane++) {                                                                                        \
+            lowest = low[lane] < lowest ? low[lane] : lowest;                                                                                \
+            highest = high[lane] > highest ? high[lane] : highest;                                                                           \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        for (; i < count; i++) {                                                                                                             \
+            lowest = data[i] < lowest ? data[i] : lowest;                                                                                    \
+            highest = data[i] > highest ? data[i] : highest;                                                                                 \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        *min = lowest;                                                                                                                       \
+        *max = highest;                                                                                                                      \
+    }                                                                                                                                        \
+                                                                                                                                             \
+    attributes static void _scan_##suffix##_##isa(type* data, size_t count, int inclusive)                                                   \
+    {                                                                                                                                        \
+        typedef type _vector __attribute__((vector_size(width)));                                                                            \
+        typedef mask_type _mask __attribute__((vector_size(width)));                                                                         \
+        const size_t lanes = width / sizeof(type);                                                                                           \
+        const _vector zero = { 0 };                                                                                                          \
+        _mask iota;                                                                                                                          \
+        for (size_t lane = 0; lane < lanes; lane++) {                                                                                        \
+            iota[lane] = lane;                                                                                                               \
+        }                                                                                                                                    \
+        type carry = 0;                                                                                                                      \
+        size_t i = 0;                                                                                                                        \
+                                                                                                                                             \
+        for (; i + lanes <= count; i += lanes) {                                                                                             \
+            _vector values;                                                                                                                  \
+            memcpy(&values, data + i, sizeof(values));                                                                                       \
+            /* Prefix sum in log steps; shifted lanes wrap to the indices of `zero`. */                                                       \
+            values += __builtin_shuffle(values, zero, iota - 1);                                                                             \
+            if (lanes > 2) {                                                                                                                 \
+                values += __builtin_shuffle(values, zero, iota - 2);                                                                         \
+            }                                                                                                                                \
+            if (lanes > 4) {                                                                                                                 \
+                values += __builtin_shuffle(values, zero, iota - 4);                                                                         \
+            }                                                                                                                                \
+            if (lanes > 8) {                                                                                                                 \
+                values += __builtin_shuffle(values, zero, iota - 8);                                                                         \
+            }                                                                                                                                \
+                                                                                                                                             \
+            type last = values[lanes - 1];                                                                                                   \
+            if (!inclusive) {                                                                                                                \
+                values = __builtin_shuffle(values, zero, iota - 1);                                                                          \
+            }                                                                                                                                \
+                                                                                                                                             \
+            values += carry;                                                                                                                 \
+            memcpy(data + i, &values, sizeof(values));                                                                                       \
+            carry += last;                                                                                                                   \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        for (; i < count; i++) {                                                                                                             \
+            type value = data[i];                                                                                                            \
+            carry += value;                                                                                                                  \
+            data[i] = inclusive ? carry : carry - value;                                                                                     \
+        }                                                                                                                                    \
+    }                                                                                                                                        \
+                                                                                                                                             \
+    attributes static void _transform_##suffix##_##isa(type* data, size_t count, _choco_numeric_op op, type a, type b)                       \
+    {                                                                                                                                        \
+        typedef type _vector __attribute__((vector_size(width)));                                                                            \
+        typedef mask_type _mask __attribute__((vector_size(width)));                                                                         \
+        const size_t lanes = width / sizeof(type);                                                                                           \
+        const _vector low = (_vector) { 0 } + a;                                                                                             \
+        const _vector high = (_vector) { 0 } + b;                                                                                            \
+        size_t i = 0;                                                                                                                        \
+                                                                                                                                             \
+        for (; i + lanes <= count; i += lanes) {                                                                                             \
+            _vector values;                                                                                                                  \
+            memcpy(&values, data + i, sizeof(values));                                                                                       \
+            if (op == _CHOCO_NUMERIC_SCALE) {                                                                                                \
+                values *= low;                                                                                                               \
+            } else if (op == _CHOCO_NUMERIC_ADD) {                                                                                           \
+                values += low;                                                                                                               \
+            } else {                                                                                                                         \
+                values = _select(values < low, low, values, _vector, _mask);                                                                 \
+                values = _select(values > high, high, values, _vector, _mask);                                                               \
+            }                                                                                                                                \
+            memcpy(data + i, &values, sizeof(values));                                                                                       \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        for (; i < count; i++) {                                                                                                             \
+            type value = data[i];                                                                                                            \
+            if (op == _CHOCO_NUMERIC_SCALE) {                                                                                                \
+                value *= a;                                                                                                                  \
+            } else if (op == _CHOCO_NUMERIC_ADD) {                                                                                           \
+                value += a;                                                                                                                  \
+            } else {                                                                                                                         \
+                value = value < a ? a : value > b ? b : value;                                                                               \
+            }                                                                                                                                \
+            data[i] = value;                                                                                                                 \
+        }                                                                                                                                    \
+    }                                                                                                                                        \
+                                                                                                                                             \
+    attributes static void _histogram_##suffix##_##isa(const type* data, size_t count, double low, double high, size_t bins, size_t* tables) \
+    {                                                                                                                                        \
+        typedef type _vector __attribute__((vector_size(width)));                                                                            \
+        typedef double _real __attribute__((vector_size(width / sizeof(type) * sizeof(double))));                                            \
+        typedef int64_t _index __attribute__((vector_size(width / sizeof(type) * sizeof(double))));                                          \
+        const size_t lanes = width / sizeof(type);                                                                                           \
+        const size_t stride = bins + 1;                                                                                                      \
+        const double scale = (double)bins / (high - low);                                                                                    \
+        size_t i = 0;                                                                                                                        \
+                                                                                                                                             \
+        for (; i + lanes <= count; i += lanes) {                                                                                             \
+            _vector values;                                                                                                                  \
+            memcpy(&values, data + i, sizeof(values));                                                                                       \
+            _real real = __builtin_convertvector(values, _real);                                                                             \
+            _index inside = (real >= low) & (real < high);                                                                                   \
+            _real position = (_real)((_index)((real - low) * scale) & inside);                                                               \
+            _index index = __builtin_convertvector(position, _index);                                                                        \
+            index += index >= (int64_t)bins;                                                                                                 \
+            index = (index & inside) | ((int64_t)bins & ~inside);                                                                            \
+                                                                                                                                             \
+            for (size_t lane = 0; lane < lanes; lane++) {                                                                                    \
+                tables[(lane % _TABLES) * stride + index[lane]]++;                                                                           \
+            }                                                                                                                                \
+        }                                                                                                                                    \
+                                                                                                                                             \
+        for (; i < count; i++) {                                                                                                             \
+            double real = (double)data[i];                                                                                                   \
+            size_t index = bins;                                                                                                             \
+            if (real >= low && real < high) {                                                                                                \
+                index = (size_t)((real - low) * scale);                                                                                      \
+                index -= index >= bins;                                                                                                      \
+            }                                                                                                                                \
+            tables[(i % _TABLES) * stride + index]++;                                                                                        \
+        }                                                                                                                                    \
+    }
+
+// The tables come from the heap rather than from the allocator of the list, which may not
+// serve blocks of that size.
+static size_t* _allocate_tables(size_t bins)
+{
+    _allocator allocator = _choco_arraylist_heap_allocator();
+    size_t size = sizeof(size_t) * _TABLES * (bins + 1);
+    size_t* tables = allocator.allocate(&allocator, size);
+    if (tables != NULL) {
+        memset(tables, 0, size);
+    }
+    return tables;
+}
+
+// Sums the tables into `bins`; the extra counter of every table holds the values out of range.
+static void _merge_tables(size_t* tables, size_t* bins, size_t count)
+{
+    for (size_t bin = 0; bin < count; bin++) {
+        bins[bin] = 0;
+        for (size_t table = 0; table < _TABLES; table++) {
+            bins[bin] += tables[table * (count + 1) + bin];
+        }
+    }
+
+    _allocator allocator = _choco_arraylist_heap_allocator();
+    allocator.deallocate(&allocator, tables);
+}
+
+#define _define_numeric(suffix, type, mask_type, sum_type)                                                                   \
+    _define_kernels(suffix, type, mask_type, sum_type, generic, 16, )                                                        \
+    _define_kernels(suffix, type, mask_type, sum_type, avx2, 32, __attribute__((target("avx2"))))                            \
+    _define_kernels(suffix, type, mask_type, sum_type, avx512, 64, __attribute__((target("avx512f,avx512bw"))))              \
+                                                                                                                             \
+    _result _choco_numeric_sum_##suffix(_choco_arraylist arrlist, sum_type* sum)                                             \
+    {                                                                                                                        \
+        if (!_is_list_of(arrlist, type) || sum == NULL) {                                                                    \
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;                                                                            \
+        }                                                                                                                    \
+                                                                                                                             \
+        *sum = _dispatch(_sum_##suffix, arrlist, _choco_arraylist_length(arrlist));                                          \
+        return _CHOCO_ARRAYLIST_RESULT_OK;                                                                                   \
+    }                                                                                                                        \
+                                                                                                                             \
+    _result _choco_numeric_minmax_##suffix(_choco_arraylist arrlist, type* min, type* max)                                   \
+    {                                                                                                                        \
+        if (!_is_list_of(arrlist, type) || _choco_arraylist_length(arrlist) == 0) {                                          \
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;                                                                            \
+        }                                                                                                                    \
+                                                                                                                             \
+        type lowest, highest;                                                                                                \
+        _dispatch(_minmax_##suffix, arrlist, _choco_arraylist_length(arrlist), &lowest, &highest);                           \
+        if (min != NULL) {                                                                                                   \
+            *min = lowest;                                                                                                   \
+        }                                                                                                                    \
+        if (max != NULL) {                                                                                                   \
+            *max = highest;                                                                                                  \
+        }                                                                                                                    \
+        return _CHOCO_ARRAYLIST_RESULT_OK;                                                                                   \
+    }                                                                                                                        \
+                                                                                                                             \
+    _result _choco_numeric_min_##suffix(_choco_arraylist arrlist, type* min)                                                 \
+    {                                                                                                                        \
+        return min == NULL ? _CHOCO_ARRAYLIST_RESULT_ERROR : _choco_numeric_minmax_##suffix(arrlist, min, NULL);             \
+    }                                                                                                                        \
+                                                                                                                             \
+    _result _choco_numeric_max_##suffix(_choco_arraylist arrlist, type* max)                                                 \
+    {                                                                                                                        \
+        return max == NULL ? _CHOCO_ARRAYLIST_RESULT_ERROR : _choco_numeric_minmax_##suffix(arrlist, NULL, max);             \
+    }                                                                                                                        \
+                                                                                                                             \
+    _result _choco_numeric_inclusive_scan_##suffix(_choco_arraylist arrlist)                                                 \
+    {                                                                                                                        \
+        if (!_is_writable_list_of(arrlist, type)) {                                                                          \
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;                                                                            \
+        }                                                                                                                    \
+                                                                                                                             \
+        _dispatch(_scan_##suffix, arrlist, _choco_arraylist_length(arrlist), 1);                                             \
+        return _CHOCO_ARRAYLIST_RESULT_OK;                                                                                   \
+    }                                                                                                                        \
+                                                                                                                             \
+    _result _choco_numeric_exclusive_scan_##suffix(_choco_arraylist arrlist)                                                 \
+    {                                                                                                                        \
+        if (!_is_writable_list_of(arrlist, type)) {                                                                          \
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;                                                                            \
+        }                                                                                                                    \
+                                                                                                                             \
+        _dispatch(_scan_##suffix, arrlist, _choco_arraylist_length(arrlist), 0);                                             \
+        return _CHOCO_ARRAYLIST_RESULT_OK;                                                                                   \
+    }                                                                                                                        \
+                                                                                                                             \
+    _result _choco_numeric_transform_##suffix(_choco_arraylist arrlist, _choco_numeric_op op, type a, type b)                \
+    {                                                                                                                        \
+        if (!_is_writable_list_of(arrlist, type) || op < _CHOCO_NUMERIC_SCALE || op > _CHOCO_NUMERIC_CLAMP) {                \
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;                                                                            \
+        }                                                                                                                    \
+                                                                                                                             \
+        _dispatch(_transform_##suffix, arrlist, _choco_arraylist_length(arrlist), op, a, b);                                 \
+        return _CHOCO_ARRAYLIST_RESULT_OK;                                                                                   \
+    }                                                                                                                        \
+                                                                                                                             \
+    _result _choco_numeric_histogram_##suffix(_choco_arraylist arrlist, type low, type high, size_t* bins, size_t count)     \
+    {                                                                                                                        \
+        if (!_is_list_of(arrlist, type) || bins == NULL || count == 0 || !(low < high)) {                                    \
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;                                                                            \
+        }                                                                                                                    \
+                                                                                                                             \
+        size_t* tables = _allocate_tables(count);                                                                            \
+        if (tables == NULL) {                                                                                                \
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;                                                                            \
+        }                                                                                                                    \
+                                                                                                                             \
+        _dispatch(_histogram_##suffix, arrlist, _choco_arraylist_length(arrlist), (double)low, (double)high, count, tables); \
+        _merge_tables(tables, bins, count);                                                                                  \
+        return _CHOCO_ARRAYLIST_RESULT_OK;                                                                                   \
+    }
+
+_define_numeric(i32, int32_t, int32_t, int64_t)
+_define_numeric(i64, int64_t, int64_t, int64_t)
+_define_numeric(u32, uint32_t, int32_t, uint64_t)
+_define_numeric(u64, uint64_t, int64_t, uint64_t)
+_define_numeric(f32, float, int32_t, double)
+_define_numeric(f64, double, int64_t, double)
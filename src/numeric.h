@@ -0,0 +1,52 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum _choco_numeric_op {
+    // x * a
+    _CHOCO_NUMERIC_SCALE,
+    // x + a
+    _CHOCO_NUMERIC_ADD,
+    // x clamped to [a, b]
+    _CHOCO_NUMERIC_CLAMP,
+} _choco_numeric_op;
+
+// Kernels over lists of one numeric type, declared for every suffix below. They return an
+// error when the element size of the list does not match the type, when `min`, `max` or
+// `minmax` get an empty list, and when the in-place ones (scans and transform) get a shared
+// list. Results involving NaN are unspecified.
+//
+//   sum             adds the elements into the wider `sum_type`
+//   min, max        smallest and largest element
+//   inclusive_scan  replaces every element by the sum of the elements up to it
+//   exclusive_scan  replaces every element by the sum of the elements before it
+//   transform       applies `op` with operands `a` and `b` to every element
+//   histogram       counts the elements of [low, high) in `count` bins of equal width
+#define _choco_numeric_declare(suffix, type, sum_type)                                                                        \
+    _choco_arraylist_result _choco_numeric_sum_##suffix(_choco_arraylist arrlist, sum_type* sum);                            \
+    _choco_arraylist_result _choco_numeric_min_##suffix(_choco_arraylist arrlist, type* min);                                \
+    _choco_arraylist_result _choco_numeric_max_##suffix(_choco_arraylist arrlist, type* max);                                \
+    _choco_arraylist_result _choco_numeric_minmax_##suffix(_choco_arraylist arrlist, type* min, type* max);                  \
+    _choco_arraylist_result _choco_numeric_inclusive_scan_##suffix(_choco_arraylist arrlist);                                \
+    _choco_arraylist_result _choco_numeric_exclusive_scan_##suffix(_choco_arraylist arrlist);                                \
+    _choco_arraylist_result _choco_numeric_transform_##suffix(_choco_arraylist arrlist, _choco_numeric_op op, type a, type b); \
+    _choco_arraylist_result _choco_numeric_histogram_##suffix(_choco_arraylist arrlist, type low, type high, size_t* bins, size_t count);
+
+_choco_numeric_declare(i32, int32_t, int64_t)
+_choco_numeric_declare(i64, int64_t, int64_t)
+_choco_numeric_declare(u32, uint32_t, uint64_t)
+_choco_numeric_declare(u64, uint64_t, uint64_t)
+_choco_numeric_declare(f32, float, double)
+_choco_numeric_declare(f64, double, double)
+
+#ifdef __cplusplus
+}
+#endif
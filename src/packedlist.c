@@ -0,0 +1,340 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "packedlist.h"
+#include "cpu.h"
+#include <immintrin.h>
+
+typedef _choco_packedlist _list;
+typedef _choco_packedlist_block _block;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _BLOCK _CHOCO_PACKEDLIST_BLOCK
+
+// Values are read with one unaligned 8 byte load, so the payload always ends with 8 zero bytes
+// and packed widths stop at 56 bits, where a value plus its bit shift still fits in a load.
+// Wider blocks are stored on 64 bits, which are byte aligned.
+#define _PADDING (8)
+#define _MAX_PACKED_BITS (56)
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _block_bytes(bits) \
+    ((size_t)(bits) * _BLOCK / 8)
+
+#define _mask_for(bits) \
+    ((bits) == 64 ? ~UINT64_C(0) : (UINT64_C(1) << (bits)) - 1)
+
+static uint64_t _load(const uint8_t* bytes)
+{
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+static uint64_t _extract(const uint8_t* payload, uint32_t bits, size_t index)
+{
+    size_t position = index * bits;
+    return (_load(payload + position / 8) >> (position % 8)) & _mask_for(bits);
+}
+
+// Turns the block in `tail` into offsets from `base`, and returns the width of the largest one.
+static uint32_t _prepare(const _list* list, uint64_t* offsets, uint64_t* base)
+{
+    const uint64_t* values = list->tail;
+    uint64_t merged = 0;
+
+    if (list->mode == _CHOCO_PACKEDLIST_DELTA) {
+        *base = values[0];
+        offsets[0] = 0;
+        for (size_t i = 1; i < _BLOCK; i++) {
+            offsets[i] = values[i] - values[i - 1];
+            merged |= offsets[i];
+        }
+    } else {
+        uint64_t min = values[0];
+        for (size_t i = 1; i < _BLOCK; i++) {
+            min = values[i] < min ? values[i] : min;
+        }
+
+        *base = min;
+        for (size_t i = 0; i < _BLOCK; i++) {
+            offsets[i] = values[i] - min;
+            merged |= offsets[i];
+        }
+    }
+
+    uint32_t bits = merged == 0 ? 0 : 64 - __builtin_clzll(merged);
+    return bits > _MAX_PACKED_BITS ? 64 : bits;
+}
+
+static _result _flush(_list* list)
+{
+    uint64_t offsets[_BLOCK];
+    _block block;
+    block.bits = _prepare(list, offsets, &block.base);
+
+    size_t bytes = _block_bytes(block.bits);
+    size_t used = _choco_arraylist_length(list->payload);
+    _choco_arraylist payload = _choco_arraylist_add_n(list->payload, bytes);
+    list->payload = payload;
+    if (_choco_arraylist_length(payload) != used + bytes) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t count = _choco_arraylist_length(list->blocks);
+    _choco_arraylist blocks = _choco_arraylist_add(list->blocks);
+    list->blocks = blocks;
+    if (_choco_arraylist_length(blocks) != count + 1) {
+        _choco_arraylist_get_header(payload)->used = used;
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    // The block starts over the padding of the previous one, which add_n left zeroed.
+    block.offset = used - _PADDING;
+    uint8_t* out = (uint8_t*)payload + block.offset;
+    for (size_t i = 0; i < _BLOCK && block.bits != 0; i++) {
+        size_t position = i * block.bits;
+        uint64_t word = _load(out + position / 8) | (offsets[i] << (position % 8));
+        memcpy(out + position / 8, &word, sizeof(word));
+    }
+
+    *(_block*)_choco_arraylist_at(blocks, count) = block;
+    list->tail_length = 0;
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+static void _unpack_scalar(const uint8_t* payload, const _block* block, int delta, uint64_t* out)
+{
+    uint64_t running = block->base;
+    for (size_t i = 0; i < _BLOCK; i++) {
+        uint64_t value = _extract(payload, block->bits, i);
+        running = delta ? running + value : block->base + value;
+        out[i] = running;
+    }
+}
+
+// Four values per iteration: one gather of the four 8 byte words holding them, a per-lane shift
+// and mask, then for delta blocks a prefix sum across the lanes carried over by the last lane.
+__attribute__((target("avx2"))) static void _unpack_avx2(const uint8_t* payload, const _block* block, int delta, uint64_t* out)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i seven = _mm256_set1_epi64x(7);
+    const __m256i mask = _mm256_set1_epi64x((long long)_mask_for(block->bits));
+    const __m256i step = _mm256_set1_epi64x(4 * (long long)block->bits);
+    __m256i position = _mm256_setr_epi64x(0, block->bits, 2 * block->bits, 3 * block->bits);
+    __m256i running = _mm256_set1_epi64x((long long)block->base);
+
+    for (size_t i = 0; i < _BLOCK; i += 4) {
+        __m256i words = _mm256_i64gather_epi64((const long long*)payload, _mm256_srli_epi64(position, 3), 1);
+        __m256i values = _mm256_and_si256(_mm256_srlv_epi64(words, _mm256_and_si256(position, seven)), mask);
+        position = _mm256_add_epi64(position, step);
+
+        if (delta) {
+            values = _mm256_add_epi64(values, _mm256_blend_epi32(_mm256_permute4x64_epi64(values, 0x90), zero, 0x03));
+            values = _mm256_add_epi64(values, _mm256_blend_epi32(_mm256_permute4x64_epi64(values, 0x40), zero, 0x0F));
+            values = _mm256_add_epi64(values, running);
+            running = _mm256_permute4x64_epi64(values, 0xFF);
+        } else {
+            values = _mm256_add_epi64(values, running);
+        }
+
+        _mm256_storeu_si256((__m256i*)(out + i), values);
+    }
+}
+
+static void _unpack(const _list* list, size_t index, uint64_t* out)
+{
+    const _block* block = (const _block*)_choco_arraylist_at(list->blocks, index);
+    const uint8_t* payload = (const uint8_t*)list->payload + block->offset;
+    int delta = list->mode == _CHOCO_PACKEDLIST_DELTA;
+
+    if (_choco_cpu_features() & _CHOCO_CPU_AVX2) {
+        _unpack_avx2(payload, block, delta, out);
+    } else {
+        _unpack_scalar(payload, block, delta, out);
+    }
+}
+
+_list* _choco_packedlist_create(_allocator allocator, _choco_packedlist_mode mode)
+{
+    if (!_is_allocator_valid(allocator)) {
+        return NULL;
+    }
+
+    if (mode != _CHOCO_PACKEDLIST_DELTA && mode != _CHOCO_PACKEDLIST_FRAME) {
+        return NULL;
+    }
+
+    _list* list = allocator.allocate(&allocator, sizeof(_list));
+    if (list == NULL) {
+        return NULL;
+    }
+
+    _choco_arraylist blocks = _choco_arraylist_create(allocator, sizeof(_block), 4);
+    _choco_arraylist payload = _choco_arraylist_create(allocator, sizeof(uint8_t), 64);
+    payload = _choco_arraylist_add_n(payload, _PADDING);
+
+    if (blocks == NULL || payload == NULL || _choco_arraylist_length(payload) != _PADDING) {
+        _choco_arraylist_destroy(blocks);
+        _choco_arraylist_destroy(payload);
+        allocator.deallocate(&allocator, list);
+        return NULL;
+    }
+
+    *list = (_list) {
+        .allocator = allocator,
+        .mode = mode,
+        .length = 0,
+        .blocks = blocks,
+        .payload = payload,
+        .tail_length = 0,
+    };
+    return list;
+}
+
+_result _choco_packedlist_destroy(_list* list)
+{
+    if (list == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _allocator allocator = list->allocator;
+    _choco_arraylist_destroy(list->blocks);
+    _choco_arraylist_destroy(list->payload);
+    allocator.deallocate(&allocator, list);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_packedlist_push(_list* list, uint64_t value)
+{
+    if (list == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    // A flush leaves `tail` as it was, so the last value is still there after one.
+    uint64_t last = list->tail[(list->tail_length + _BLOCK - 1) % _BLOCK];
+    if (list->mode == _CHOCO_PACKEDLIST_DELTA && list->length > 0 && value < last) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    list->tail[list->tail_length++] = value;
+    list->length++;
+
+    if (list->tail_length == _BLOCK && _flush(list) != _CHOCO_ARRAYLIST_RESULT_OK) {
+        list->tail_length--;
+        list->length--;
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_packedlist_push_n(_list* list, const uint64_t* values, size_t count)
+{
+    if (list == NULL || (values == NULL && count > 0)) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (_choco_packedlist_push(list, values[i]) != _CHOCO_ARRAYLIST_RESULT_OK) {
+            return _CHOCO_ARRAYLIST_RESULT_ERROR;
+        }
+    }
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+size_t _choco_packedlist_length(const _list* list)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->length;
+}
+
+_result _choco_packedlist_get(const _list* list, size_t index, uint64_t* value)
+{
+    if (list == NULL || value == NULL || index >= list->length) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t packed = list->length - list->tail_length;
+    if (index >= packed) {
+        *value = list->tail[index - packed];
+        return _CHOCO_ARRAYLIST_RESULT_OK;
+    }
+
+    // The skip index leads straight to the block; delta blocks still sum up to the value.
+    const _block* block = (const _block*)_choco_arraylist_at(list->blocks, index / _BLOCK);
+    const uint8_t* payload = (const uint8_t*)list->payload + block->offset;
+    size_t position = index % _BLOCK;
+    uint64_t result = block->base;
+
+    if (list->mode == _CHOCO_PACKEDLIST_DELTA) {
+        for (size_t i = 1; i <= position; i++) {
+            result += _extract(payload, block->bits, i);
+        }
+    } else {
+        result += _extract(payload, block->bits, position);
+    }
+
+    *value = result;
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_choco_arraylist _choco_packedlist_decode(const _list* list, size_t from, size_t count, _choco_arraylist dst)
+{
+    if (list == NULL || dst == NULL) {
+        return dst;
+    }
+
+    if (_choco_arraylist_element_size(dst) != sizeof(uint64_t) || from > list->length || count > list->length - from) {
+        return dst;
+    }
+
+    size_t used = _choco_arraylist_length(dst);
+    dst = _choco_arraylist_add_n(dst, count);
+    if (_choco_arraylist_length(dst) != used + count) {
+        return dst;
+    }
+
+    uint64_t* out = (uint64_t*)dst + used;
+    size_t packed = list->length - list->tail_length;
+    size_t end = from + count;
+    size_t index = from;
+
+    // Whole blocks are unpacked in place; blocks cut by the range go through a buffer.
+    while (index < end && index < packed) {
+        size_t offset = index % _BLOCK;
+        size_t take = _BLOCK - offset;
+        take = take < end - index ? take : end - index;
+
+        if (take == _BLOCK) {
+            _unpack(list, index / _BLOCK, out);
+        } else {
+            uint64_t buffer[_BLOCK];
+            _unpack(list, index / _BLOCK, buffer);
+            memcpy(out, buffer + offset, take * sizeof(uint64_t));
+        }
+
+        out += take;
+        index += take;
+    }
+
+    if (index < end) {
+        memcpy(out, list->tail + (index - packed), (end - index) * sizeof(uint64_t));
+    }
+    return dst;
+}
+
+size_t _choco_packedlist_sizeof(const _list* list)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    return sizeof(_list) + _choco_arraylist_sizeof(list->blocks) + _choco_arraylist_sizeof(list->payload);
+}
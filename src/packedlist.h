@@ -0,0 +1,61 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _CHOCO_PACKEDLIST_BLOCK (128)
+
+typedef enum _choco_packedlist_mode {
+    // Sorted values: blocks store the differences between neighbours.
+    _CHOCO_PACKEDLIST_DELTA,
+    // Any values: blocks store the distance to the smallest value of the block.
+    _CHOCO_PACKEDLIST_FRAME,
+} _choco_packedlist_mode;
+
+// Entry of the skip index: every block of 128 values is packed on `bits` bits per value,
+// starting at byte `offset` of the payload. Blocks are 16 * `bits` bytes long.
+typedef struct _choco_packedlist_block {
+    uint64_t base;
+    uint64_t offset;
+    uint32_t bits;
+} _choco_packedlist_block;
+
+// Append-only list of 64-bit unsigned integers. Full blocks are packed; the last partial
+// block stays in `tail` until it fills up.
+typedef struct _choco_packedlist {
+    _choco_arraylist_allocator allocator;
+    _choco_packedlist_mode mode;
+    size_t length;
+    _choco_arraylist blocks;
+    _choco_arraylist payload;
+    size_t tail_length;
+    uint64_t tail[_CHOCO_PACKEDLIST_BLOCK];
+} _choco_packedlist;
+
+_choco_packedlist* _choco_packedlist_create(_choco_arraylist_allocator allocator, _choco_packedlist_mode mode);
+_choco_arraylist_result _choco_packedlist_destroy(_choco_packedlist* list);
+
+// In delta mode, a value smaller than the last one is rejected with an error.
+_choco_arraylist_result _choco_packedlist_push(_choco_packedlist* list, uint64_t value);
+_choco_arraylist_result _choco_packedlist_push_n(_choco_packedlist* list, const uint64_t* values, size_t count);
+
+size_t _choco_packedlist_length(const _choco_packedlist* list);
+_choco_arraylist_result _choco_packedlist_get(const _choco_packedlist* list, size_t index, uint64_t* value);
+
+// Appends values `from` to `from + count` to `dst`, an arraylist of 8 byte elements, and
+// returns it. `dst` is returned unchanged when the range or the element size is invalid.
+_choco_arraylist _choco_packedlist_decode(const _choco_packedlist* list, size_t from, size_t count, _choco_arraylist dst);
+
+// Bytes held by the list, skip index and payload included.
+size_t _choco_packedlist_sizeof(const _choco_packedlist* list);
+
+#ifdef __cplusplus
+}
+#endif
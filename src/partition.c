@@ -0,0 +1,293 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "partition.h"
+#include <pthread.h>
+#include <stdint.h>
+
+typedef _choco_arraylist_header _header;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _LINE (64)
+#define _MAX_BITS _CHOCO_PARTITION_MAX_BITS
+#define _MAX_THREADS _CHOCO_PARTITION_MAX_THREADS
+
+#define _round_up(value, granule) \
+    (((value) + (granule) - 1) / (granule) * (granule))
+
+// A chunk of the input handled by one thread. `positions` first holds the histogram of the
+// chunk, then the index in the output where its next element of each partition goes.
+typedef struct _job {
+    const char* records;
+    size_t begin;
+    size_t end;
+    size_t size;
+    size_t key_offset;
+    size_t key_size;
+    size_t mask;
+    size_t* positions;
+    char* out;
+    // Write-combining buffers: one cache line per partition, written to the output once full,
+    // so that the scatter touches one output page per line instead of one per element.
+    char* buffers;
+    uint8_t* fill;
+    void (*scatter)(struct _job* job);
+} _job;
+
+static uint64_t _read_key(const char* key, size_t key_size)
+{
+    switch (key_size) {
+    case 1:
+        return *(const uint8_t*)key;
+    case 2: {
+        uint16_t value;
+        memcpy(&value, key, sizeof(value));
+        return value;
+    }
+    case 4: {
+        uint32_t value;
+        memcpy(&value, key, sizeof(value));
+        return value;
+    }
+    default: {
+        uint64_t value;
+        memcpy(&value, key, sizeof(value));
+        return value;
+    }
+    }
+}
+
+#define _partition_of(job, record) \
+    (_read_key((record) + (job)->key_offset, (job)->key_size) & (job)->mask)
+
+static void _histogram(_job* job)
+{
+    memset(job->positions, 0, (job->mask + 1) * sizeof(size_t));
+    for (size_t i = job->begin; i < job->end; i++) {
+        job->positions[_partition_of(job, job->records + i * job->size)]++;
+    }
+}
+
+static void _drain(_job* job)
+{
+    for (size_t p = 0; p <= job->mask; p++) {
+        size_t fill = job->fill[p];
+        memcpy(job->out + job->positions[p] * job->size, job->buffers + p * _LINE, fill * job->size);
+        job->positions[p] += fill;
+        job->fill[p] = 0;
+    }
+}
+
+// Scatter kernels. Elements of 4 to 32 bytes get loops where every copy has a length known at
+// compile time; other sizes up to half a line go through `memcpy` with the same buffering.
+#define _define_scatter(name, bytes)                                                           \
+    static void _scatter_##name(_job* job)                                                     \
+    {                                                                                          \
+        const size_t capacity = _LINE / (bytes);                                               \
+        for (size_t i = job->begin; i < job->end; i++) {                                       \
+            const char* record = job->records + i * (bytes);                                   \
+            size_t p = _partition_of(job, record);                                             \
+            char* buffer = job->buffers + p * _LINE;                                           \
+            size_t fill = job->fill[p];                                                        \
+                                                                                               \
+            memcpy(buffer + fill * (bytes), record, (bytes));                                  \
+            if (++fill == capacity) {                                                          \
+                memcpy(job->out + job->positions[p] * (bytes), buffer, capacity * (bytes));    \
+                job->positions[p] += capacity;                                                 \
+                fill = 0;                                                                      \
+            }                                                                                  \
+            job->fill[p] = (uint8_t)fill;                                                      \
+        }                                                                                      \
+        _drain(job);                                                                           \
+    }
+
+_define_scatter(4, 4)
+_define_scatter(8, 8)
+_define_scatter(16, 16)
+_define_scatter(32, 32)
+_define_scatter(generic, job->size)
+
+// Elements larger than half a line fill whole lines by themselves and skip the buffers.
+static void _scatter_direct(_job* job)
+{
+    for (size_t i = job->begin; i < job->end; i++) {
+        const char* record = job->records + i * job->size;
+        size_t p = _partition_of(job, record);
+        memcpy(job->out + job->positions[p]++ * job->size, record, job->size);
+    }
+}
+
+static void (*_scatter_for(size_t size))(_job*)
+{
+    switch (size) {
+    case 4:
+        return _scatter_4;
+    case 8:
+        return _scatter_8;
+    case 16:
+        return _scatter_16;
+    case 32:
+        return _scatter_32;
+    default:
+        return 2 * size <= _LINE ? _scatter_generic : _scatter_direct;
+    }
+}
+
+static void* _run_histogram(void* job)
+{
+    _histogram(job);
+    return NULL;
+}
+
+static void* _run_scatter(void* job)
+{
+    ((_job*)job)->scatter(job);
+    return NULL;
+}
+
+// Runs `routine` on every job, the first on the calling thread. A thread that cannot be
+// started has its job run on the calling thread too.
+static void _run(_job* jobs, unsigned threads, void* (*routine)(void*))
+{
+    pthread_t handles[_MAX_THREADS];
+    int started[_MAX_THREADS] = { 0 };
+
+    for (unsigned t = 1; t < threads; t++) {
+        started[t] = pthread_create(&handles[t], NULL, routine, &jobs[t]) == 0;
+    }
+
+    routine(&jobs[0]);
+    for (unsigned t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(handles[t], NULL);
+        } else {
+            routine(&jobs[t]);
+        }
+    }
+}
+
+// Makes room for `count` more elements of `*out` without adding them; false when it could not
+// grow.
+static int _reserve(_choco_arraylist* out, size_t count)
+{
+    _header* header = _choco_arraylist_get_header(*out);
+    size_t used = header->used;
+
+    if (used + count > header->allocated) {
+        *out = _choco_arraylist_resize(*out, used + count);
+    } else {
+        *out = _choco_arraylist_unshare(*out);
+    }
+
+    header = _choco_arraylist_get_header(*out);
+    return used + count <= header->allocated && _choco_arraylist_is_shared(*out) == _CHOCO_ARRAYLIST_RESULT_NO;
+}
+
+// Leaves every partition empty, so that a failure shows in `offsets` as well: the partitions
+// then span fewer elements than `arrlist` holds.
+static _choco_arraylist _fail(_choco_arraylist out, size_t* offsets, unsigned radix_bits)
+{
+    if (offsets != NULL && radix_bits <= _MAX_BITS) {
+        size_t length = _choco_arraylist_length(out);
+        for (size_t p = 0; p <= (size_t)1 << radix_bits; p++) {
+            offsets[p] = length;
+        }
+    }
+    return out;
+}
+
+static _choco_arraylist _partition(_choco_arraylist arrlist, size_t key_offset, size_t key_size, unsigned radix_bits, _choco_arraylist out, size_t* offsets, unsigned threads)
+{
+    if (arrlist == NULL || out == NULL || arrlist == out || offsets == NULL || radix_bits > _MAX_BITS) {
+        return _fail(out, offsets, radix_bits);
+    }
+
+    if (key_size != 1 && key_size != 2 && key_size != 4 && key_size != 8) {
+        return _fail(out, offsets, radix_bits);
+    }
+
+    _header* header = _choco_arraylist_get_header(arrlist);
+    size_t size = header->size;
+    size_t count = header->used;
+    if (_choco_arraylist_element_size(out) != size || key_offset > size || size - key_offset < key_size) {
+        return _fail(out, offsets, radix_bits);
+    }
+
+    threads = threads == 0 ? 1 : threads > _MAX_THREADS ? _MAX_THREADS : threads;
+    if (threads > count) {
+        threads = count > 0 ? (unsigned)count : 1;
+    }
+
+    // Jobs, then the histograms, the buffer fills and the buffers of every thread.
+    size_t partitions = (size_t)1 << radix_bits;
+    size_t histograms = threads * partitions * sizeof(size_t);
+    size_t fills = threads * partitions;
+    size_t scratch = threads * sizeof(_job) + histograms + fills + _LINE + threads * partitions * _LINE;
+
+    // The scratch can take hundreds of MB at the widest radix, more than the allocator of the
+    // lists may be able to give, so it comes from the heap.
+    _allocator allocator = _choco_arraylist_heap_allocator();
+    char* memory = allocator.allocate(&allocator, scratch);
+    if (memory == NULL) {
+        return _fail(out, offsets, radix_bits);
+    }
+
+    if (!_reserve(&out, count)) {
+        allocator.deallocate(&allocator, memory);
+        return _fail(out, offsets, radix_bits);
+    }
+
+    _job* jobs = (_job*)memory;
+    size_t* positions = (size_t*)(memory + threads * sizeof(_job));
+    uint8_t* fill = (uint8_t*)positions + histograms;
+    char* buffers = (char*)_round_up((uintptr_t)(fill + fills), _LINE);
+    memset(fill, 0, fills);
+
+    for (unsigned t = 0; t < threads; t++) {
+        jobs[t] = (_job) {
+            .records = arrlist,
+            .begin = count * t / threads,
+            .end = count * (t + 1) / threads,
+            .size = size,
+            .key_offset = key_offset,
+            .key_size = key_size,
+            .mask = partitions - 1,
+            .positions = positions + t * partitions,
+            .out = out,
+            .buffers = buffers + t * partitions * _LINE,
+            .fill = fill + t * partitions,
+            .scatter = _scatter_for(size),
+        };
+    }
+
+    _run(jobs, threads, _run_histogram);
+
+    // Each partition gets the runs of the threads in order, which keeps the input order.
+    size_t next = _choco_arraylist_length(out);
+    for (size_t p = 0; p < partitions; p++) {
+        offsets[p] = next;
+        for (unsigned t = 0; t < threads; t++) {
+            size_t run = jobs[t].positions[p];
+            jobs[t].positions[p] = next;
+            next += run;
+        }
+    }
+    offsets[partitions] = next;
+
+    _run(jobs, threads, _run_scatter);
+
+    _choco_arraylist_get_header(out)->used += count;
+    allocator.deallocate(&allocator, memory);
+    return out;
+}
+
+_choco_arraylist _choco_partition(_choco_arraylist arrlist, size_t key_offset, size_t key_size, unsigned radix_bits, _choco_arraylist out, size_t* offsets)
+{
+    return _partition(arrlist, key_offset, key_size, radix_bits, out, offsets, 1);
+}
+
+_choco_arraylist _choco_partition_parallel(_choco_arraylist arrlist, size_t key_offset, size_t key_size, unsigned radix_bits, _choco_arraylist out, size_t* offsets, unsigned threads)
+{
+    return _partition(arrlist, key_offset, key_size, radix_bits, out, offsets, threads);
+}
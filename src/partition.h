@@ -0,0 +1,29 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _CHOCO_PARTITION_MAX_BITS (16)
+#define _CHOCO_PARTITION_MAX_THREADS (64)
+
+// Appends the elements of `arrlist` to `out`, grouped by the low `radix_bits` bits of their
+// key, an unsigned integer of 1, 2, 4 or 8 bytes at `key_offset`. Elements keep their order
+// within a partition. Partition `p` spans `offsets[p]` to `offsets[p + 1]` in `out`, so
+// `offsets` holds 2^radix_bits + 1 entries. Returns `out`, left untouched when the element
+// sizes differ, the key does not fit in an element, `radix_bits` is above the maximum or memory
+// runs out; every partition is then empty in `offsets` when `radix_bits` is valid.
+_choco_arraylist _choco_partition(_choco_arraylist arrlist, size_t key_offset, size_t key_size, unsigned radix_bits, _choco_arraylist out, size_t* offsets);
+
+// Same result, with both passes split over `threads` threads, each taking a contiguous chunk of
+// `arrlist`. Their histograms are merged so that every thread writes its own runs.
+_choco_arraylist _choco_partition_parallel(_choco_arraylist arrlist, size_t key_offset, size_t key_size, unsigned radix_bits, _choco_arraylist out, size_t* offsets, unsigned threads);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "pool_allocator.h"
+#include <stdint.h>
+
+typedef _choco_arraylist_pool _pool;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _ALIGNMENT (64)
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _round_up(value, granule) \
+    (((value) + (granule) - 1) / (granule) * (granule))
+
+// Slabs are chained through their first bytes; the blocks start at the next 64 byte boundary.
+typedef struct _slab {
+    struct _slab* next;
+} _slab;
+
+static _pool* _get_pool(void* self)
+{
+    return ((_allocator*)self)->context;
+}
+
+// Carves a new slab and threads all of its blocks onto the free list.
+static int _grow(_pool* pool)
+{
+    size_t length = sizeof(_slab) + _ALIGNMENT - 1 + pool->slab_blocks * pool->block_size;
+    _slab* slab = pool->parent.allocate(&pool->parent, length);
+    if (slab == NULL) {
+        return 0;
+    }
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    char* blocks = (char*)_round_up((uintptr_t)(slab + 1), _ALIGNMENT);
+    for (size_t i = pool->slab_blocks; i > 0; i--) {
+        void** block = (void**)(blocks + (i - 1) * pool->block_size);
+        *block = pool->free_blocks;
+        pool->free_blocks = block;
+    }
+    return 1;
+}
+
+static void* _pool_alloc(void* self, size_t size)
+{
+    _pool* pool = _get_pool(self);
+    if (size > pool->block_size) {
+        return NULL;
+    }
+
+    if (pool->free_blocks == NULL && !_grow(pool)) {
+        return NULL;
+    }
+
+    void** block = pool->free_blocks;
+    pool->free_blocks = *block;
+    return block;
+}
+
+static void _pool_dealloc(void* self, void* ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    _pool* pool = _get_pool(self);
+    *(void**)ptr = pool->free_blocks;
+    pool->free_blocks = ptr;
+}
+
+_result _choco_arraylist_pool_init(_pool* pool, _allocator parent, size_t block_size, size_t slab_blocks)
+{
+    if (pool == NULL || !_is_allocator_valid(parent) || block_size == 0 || slab_blocks == 0) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    *pool = (_pool) {
+        .parent = parent,
+        .block_size = _round_up(block_size, _ALIGNMENT),
+        .slab_blocks = slab_blocks,
+        .free_blocks = NULL,
+        .slabs = NULL,
+    };
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_result _choco_arraylist_pool_release(_pool* pool)
+{
+    if (pool == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    while (pool->slabs != NULL) {
+        _slab* slab = pool->slabs;
+        pool->slabs = slab->next;
+        pool->parent.deallocate(&pool->parent, slab);
+    }
+    pool->free_blocks = NULL;
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+_allocator _choco_arraylist_pool_allocator(_pool* pool)
+{
+    _allocator allocator = {
+        .allocate = _pool_alloc,
+        .deallocate = _pool_dealloc,
+        .context = pool
+    };
+    return allocator;
+}
@@ -0,0 +1,34 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fixed size blocks carved from slabs taken from `parent`. Blocks are aligned on 64 bytes and
+// freed blocks are kept in a free list; the slabs only go back to `parent` on release.
+typedef struct _choco_arraylist_pool {
+    _choco_arraylist_allocator parent;
+    size_t block_size;
+    size_t slab_blocks;
+    void* free_blocks;
+    void* slabs;
+} _choco_arraylist_pool;
+
+// `block_size` is rounded up to a multiple of 64 bytes.
+_choco_arraylist_result _choco_arraylist_pool_init(_choco_arraylist_pool* pool, _choco_arraylist_allocator parent, size_t block_size, size_t slab_blocks);
+
+// Gives every slab back to the parent, including the blocks still in use.
+_choco_arraylist_result _choco_arraylist_pool_release(_choco_arraylist_pool* pool);
+
+// The allocator keeps a pointer to `pool`, which must outlive every block allocated from it.
+// Requests larger than a block return NULL, and the allocator has no `reallocate`.
+_choco_arraylist_allocator _choco_arraylist_pool_allocator(_choco_arraylist_pool* pool);
+
+#ifdef __cplusplus
+}
+#endif
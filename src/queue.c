@@ -0,0 +1,322 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#define _GNU_SOURCE
+#include "queue.h"
+#include <limits.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+typedef _choco_queue _queue;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _CACHE_LINE _CHOCO_QUEUE_CACHE_LINE
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _round_up(value, granule) \
+    (((value) + (granule) - 1) / (granule) * (granule))
+
+#define _is_mpsc(queue) \
+    (((queue)->mode & _CHOCO_QUEUE_MPSC) != 0)
+
+#define _is_blocking(queue) \
+    (((queue)->mode & _CHOCO_QUEUE_BLOCKING) != 0)
+
+static size_t _free_slots(uint64_t tail, uint64_t head, size_t capacity)
+{
+    int64_t used = (int64_t)(tail - head);
+    return used < 0 || (uint64_t)used >= capacity ? 0 : capacity - (size_t)used;
+}
+
+// Copies between the ring and a flat buffer, in two parts when the range wraps.
+static void _copy_in(_queue* queue, uint64_t position, const char* items, size_t count)
+{
+    size_t index = position & (queue->capacity - 1);
+    size_t first = queue->capacity - index < count ? queue->capacity - index : count;
+    memcpy(queue->slots + index * queue->size, items, first * queue->size);
+    memcpy(queue->slots, items + first * queue->size, (count - first) * queue->size);
+}
+
+static void _copy_out(const _queue* queue, uint64_t position, char* items, size_t count)
+{
+    size_t index = position & (queue->capacity - 1);
+    size_t first = queue->capacity - index < count ? queue->capacity - index : count;
+    memcpy(items, queue->slots + index * queue->size, first * queue->size);
+    memcpy(items + first * queue->size, queue->slots, (count - first) * queue->size);
+}
+
+// The side that made progress stores its index, then checks for sleepers on the other side;
+// a sleeper registers, then checks the indices again. The fences make sure that at least one
+// of them sees the other.
+static void _notify(uint32_t* epoch, uint32_t* waiting)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiting, __ATOMIC_RELAXED) != 0) {
+        __atomic_add_fetch(epoch, 1, __ATOMIC_RELEASE);
+        syscall(SYS_futex, epoch, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+static void _wait(_queue* queue, uint32_t* epoch, uint32_t* waiting, int (*is_ready)(_queue*))
+{
+    if (!_is_blocking(queue)) {
+        sched_yield();
+        return;
+    }
+
+    uint32_t seen = __atomic_load_n(epoch, __ATOMIC_ACQUIRE);
+    __atomic_add_fetch(waiting, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!is_ready(queue)) {
+        syscall(SYS_futex, epoch, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+    }
+    __atomic_sub_fetch(waiting, 1, __ATOMIC_RELAXED);
+}
+
+static int _has_room(_queue* queue)
+{
+    uint64_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    return _free_slots(tail, head, queue->capacity) > 0;
+}
+
+static int _has_items(_queue* queue)
+{
+    uint64_t head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    if (_is_mpsc(queue)) {
+        return __atomic_load_n(&queue->sequences[head & (queue->capacity - 1)], __ATOMIC_ACQUIRE) == head + 1;
+    }
+    return __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE) != head;
+}
+
+static size_t _push_spsc(_queue* queue, const char* items, size_t count)
+{
+    uint64_t tail = queue->tail;
+    size_t room = _free_slots(tail, queue->cached_head, queue->capacity);
+
+    if (room < count) {
+        queue->cached_head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+        room = _free_slots(tail, queue->cached_head, queue->capacity);
+    }
+
+    size_t moved = room < count ? room : count;
+    if (moved > 0) {
+        _copy_in(queue, tail, items, moved);
+        __atomic_store_n(&queue->tail, tail + moved, __ATOMIC_RELEASE);
+    }
+    return moved;
+}
+
+static size_t _pop_spsc(_queue* queue, char* items, size_t count)
+{
+    uint64_t head = queue->head;
+    size_t available = queue->cached_tail - head;
+
+    if (available < count) {
+        queue->cached_tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        available = queue->cached_tail - head;
+    }
+
+    size_t moved = available < count ? available : count;
+    if (moved > 0) {
+        _copy_out(queue, head, items, moved);
+        __atomic_store_n(&queue->head, head + moved, __ATOMIC_RELEASE);
+    }
+    return moved;
+}
+
+// Producers claim a run of slots with one CAS on `tail`, fill it, then publish every slot by
+// setting its sequence to its position + 1. `cached_head` is shared by the producers, and
+// passes on the acquire of `head` that made the slots free.
+static size_t _push_mpsc(_queue* queue, const char* items, size_t count)
+{
+    uint64_t tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    size_t moved;
+
+    for (;;) {
+        uint64_t head = __atomic_load_n(&queue->cached_head, __ATOMIC_ACQUIRE);
+        size_t room = _free_slots(tail, head, queue->capacity);
+
+        if (room < count) {
+            head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+            __atomic_store_n(&queue->cached_head, head, __ATOMIC_RELEASE);
+            tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+            room = _free_slots(tail, head, queue->capacity);
+        }
+
+        moved = room < count ? room : count;
+        if (moved == 0) {
+            return 0;
+        }
+
+        if (__atomic_compare_exchange_n(&queue->tail, &tail, tail + moved, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    _copy_in(queue, tail, items, moved);
+    for (size_t i = 0; i < moved; i++) {
+        uint64_t position = tail + i;
+        __atomic_store_n(&queue->sequences[position & (queue->capacity - 1)], position + 1, __ATOMIC_RELEASE);
+    }
+    return moved;
+}
+
+// The consumer takes the run of published slots at `head`; a slot claimed but not yet filled
+// ends the run even if later slots are ready.
+static size_t _pop_mpsc(_queue* queue, char* items, size_t count)
+{
+    uint64_t head = queue->head;
+    size_t moved = 0;
+
+    while (moved < count) {
+        uint64_t position = head + moved;
+        uint64_t sequence = __atomic_load_n(&queue->sequences[position & (queue->capacity - 1)], __ATOMIC_ACQUIRE);
+        if (sequence != position + 1) {
+            break;
+        }
+        moved++;
+    }
+
+    if (moved > 0) {
+        _copy_out(queue, head, items, moved);
+        __atomic_store_n(&queue->head, head + moved, __ATOMIC_RELEASE);
+    }
+    return moved;
+}
+
+_queue* _choco_queue_create(_allocator allocator, unsigned mode, size_t size, size_t capacity)
+{
+    if (!_is_allocator_valid(allocator) || size == 0 || capacity == 0) {
+        return NULL;
+    }
+
+    if (mode & ~(unsigned)(_CHOCO_QUEUE_MPSC | _CHOCO_QUEUE_BLOCKING)) {
+        return NULL;
+    }
+
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+
+    // One block: the queue and the slots start on cache lines, followed by the sequences.
+    size_t slots_offset = _round_up(sizeof(_queue), _CACHE_LINE);
+    size_t sequences_offset = slots_offset + _round_up(rounded * size, _CACHE_LINE);
+    size_t sequences_size = (mode & _CHOCO_QUEUE_MPSC) ? rounded * sizeof(uint64_t) : 0;
+    size_t required_space = _CACHE_LINE + sequences_offset + sequences_size;
+
+    void* block = allocator.allocate(&allocator, required_space);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    char* base = (char*)_round_up((uintptr_t)block, _CACHE_LINE);
+    _queue* queue = (_queue*)base;
+    memset(queue, 0, sizeof(_queue));
+    queue->allocator = allocator;
+    queue->block = block;
+    queue->slots = base + slots_offset;
+    queue->sequences = sequences_size > 0 ? (uint64_t*)(base + sequences_offset) : NULL;
+    queue->size = size;
+    queue->capacity = rounded;
+    queue->mode = mode;
+
+    if (queue->sequences != NULL) {
+        memset(queue->sequences, 0, sequences_size);
+    }
+    return queue;
+}
+
+_result _choco_queue_destroy(_queue* queue)
+{
+    if (queue == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _allocator allocator = queue->allocator;
+    allocator.deallocate(&allocator, queue->block);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+size_t _choco_queue_try_push_n(_queue* queue, const void* items, size_t count)
+{
+    if (queue == NULL || items == NULL || count == 0) {
+        return 0;
+    }
+
+    size_t moved = _is_mpsc(queue) ? _push_mpsc(queue, items, count) : _push_spsc(queue, items, count);
+    if (moved > 0 && _is_blocking(queue)) {
+        _notify(&queue->pushed, &queue->waiting_consumers);
+    }
+    return moved;
+}
+
+size_t _choco_queue_try_pop_n(_queue* queue, void* items, size_t count)
+{
+    if (queue == NULL || items == NULL || count == 0) {
+        return 0;
+    }
+
+    size_t moved = _is_mpsc(queue) ? _pop_mpsc(queue, items, count) : _pop_spsc(queue, items, count);
+    if (moved > 0 && _is_blocking(queue)) {
+        _notify(&queue->popped, &queue->waiting_producers);
+    }
+    return moved;
+}
+
+size_t _choco_queue_push_n(_queue* queue, const void* items, size_t count)
+{
+    if (queue == NULL || items == NULL) {
+        return 0;
+    }
+
+    size_t pushed = 0;
+    while (pushed < count) {
+        pushed += _choco_queue_try_push_n(queue, (const char*)items + pushed * queue->size, count - pushed);
+        if (pushed < count) {
+            _wait(queue, &queue->popped, &queue->waiting_producers, _has_room);
+        }
+    }
+    return pushed;
+}
+
+size_t _choco_queue_pop_n(_queue* queue, void* items, size_t count)
+{
+    if (queue == NULL || items == NULL || count == 0) {
+        return 0;
+    }
+
+    size_t popped;
+    while ((popped = _choco_queue_try_pop_n(queue, items, count)) == 0) {
+        _wait(queue, &queue->pushed, &queue->waiting_consumers, _has_items);
+    }
+    return popped;
+}
+
+size_t _choco_queue_length(const _queue* queue)
+{
+    if (queue == NULL) {
+        return 0;
+    }
+
+    // `head` first: `tail` never falls behind a `head` read earlier.
+    uint64_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    return tail - head < queue->capacity ? tail - head : queue->capacity;
+}
+
+size_t _choco_queue_capacity(const _queue* queue)
+{
+    if (queue == NULL) {
+        return 0;
+    }
+
+    return queue->capacity;
+}
@@ -0,0 +1,69 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _CHOCO_QUEUE_CACHE_LINE (64)
+
+typedef enum _choco_queue_mode {
+    // One producer thread and one consumer thread.
+    _CHOCO_QUEUE_SPSC = 0,
+    // Any number of producer threads and one consumer thread.
+    _CHOCO_QUEUE_MPSC = 1,
+    // Flag: `_choco_queue_push_n` and `_choco_queue_pop_n` sleep on a futex instead of
+    // yielding. Costs a full fence per batch on both sides.
+    _CHOCO_QUEUE_BLOCKING = 2,
+} _choco_queue_mode;
+
+// Bounded ring of fixed-size elements. Every index grows forever and is masked into the ring.
+// Producers and the consumer each own a cache line, where they also keep their last view of
+// the other side's index, so that the shared line is only read when the ring looks full or
+// empty. MPSC rings also have a sequence per slot, set when the slot is published.
+typedef struct _choco_queue {
+    __attribute__((aligned(_CHOCO_QUEUE_CACHE_LINE))) uint64_t tail;
+    uint64_t cached_head;
+
+    __attribute__((aligned(_CHOCO_QUEUE_CACHE_LINE))) uint64_t head;
+    uint64_t cached_tail;
+
+    __attribute__((aligned(_CHOCO_QUEUE_CACHE_LINE))) uint32_t pushed;
+    uint32_t popped;
+    uint32_t waiting_consumers;
+    uint32_t waiting_producers;
+
+    __attribute__((aligned(_CHOCO_QUEUE_CACHE_LINE))) _choco_arraylist_allocator allocator;
+    void* block;
+    char* slots;
+    uint64_t* sequences;
+    size_t size;
+    size_t capacity;
+    unsigned mode;
+} _choco_queue;
+
+// `capacity` is rounded up to a power of two.
+_choco_queue* _choco_queue_create(_choco_arraylist_allocator allocator, unsigned mode, size_t size, size_t capacity);
+_choco_arraylist_result _choco_queue_destroy(_choco_queue* queue);
+
+// Both move as many of the `count` elements as fit, without waiting, and return that number.
+size_t _choco_queue_try_push_n(_choco_queue* queue, const void* items, size_t count);
+size_t _choco_queue_try_pop_n(_choco_queue* queue, void* items, size_t count);
+
+// Pushes all `count` elements, waiting for room as needed.
+size_t _choco_queue_push_n(_choco_queue* queue, const void* items, size_t count);
+// Waits for at least one element, then pops up to `count`.
+size_t _choco_queue_pop_n(_choco_queue* queue, void* items, size_t count);
+
+// Number of elements in the queue; only a hint while other threads use it.
+size_t _choco_queue_length(const _choco_queue* queue);
+size_t _choco_queue_capacity(const _choco_queue* queue);
+
+#ifdef __cplusplus
+}
+#endif
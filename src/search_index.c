@@ -0,0 +1,206 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "search_index.h"
+
+typedef _choco_search_index _index;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _CACHE_LINE (64)
+#define _BATCH (8)
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _round_up(value, granule) \
+    (((value) + (granule) - 1) / (granule) * (granule))
+
+// Turns the node where a descent fell off the tree into the node of the lower bound: the
+// descent went right (appended a 1) on every node smaller than the key, so the lower bound
+// is the node before the last left turn. 0 means every key is smaller.
+#define _lower_bound_node(k) \
+    ((k) >> __builtin_ffsll(~(long long)(k)))
+
+typedef struct _source {
+    const char* data;
+    size_t stride;
+    size_t key_offset;
+    size_t key_size;
+} _source;
+
+static uint64_t _read_key(const _source* source, size_t position)
+{
+    const char* key = source->data + position * source->stride + source->key_offset;
+    switch (source->key_size) {
+    case 1:
+        return *(const uint8_t*)key;
+    case 2: {
+        uint16_t value;
+        memcpy(&value, key, sizeof(value));
+        return value;
+    }
+    case 4: {
+        uint32_t value;
+        memcpy(&value, key, sizeof(value));
+        return value;
+    }
+    default: {
+        uint64_t value;
+        memcpy(&value, key, sizeof(value));
+        return value;
+    }
+    }
+}
+
+// In-order walk of the implicit tree: the sorted keys land in BFS order.
+static size_t _fill(_index* index, const _source* source, size_t position, size_t k)
+{
+    if (k > index->length) {
+        return position;
+    }
+
+    position = _fill(index, source, position, 2 * k);
+    index->keys[k] = _read_key(source, position);
+    index->indices[k] = position;
+    return _fill(index, source, position + 1, 2 * k + 1);
+}
+
+// Node `k` has its descendants four levels down at `16k`..`16k + 15`: two cache lines that
+// are fetched while the next levels are compared.
+static size_t _descend(const _index* index, uint64_t key)
+{
+    const uint64_t* keys = index->keys;
+    size_t k = 1;
+
+    while (k <= index->length) {
+        __builtin_prefetch(keys + 16 * k);
+        __builtin_prefetch(keys + 16 * k + 8);
+        k = 2 * k + (keys[k] < key);
+    }
+    return _lower_bound_node(k);
+}
+
+_index* _choco_search_index_build(_choco_arraylist arrlist, size_t key_offset, size_t key_size)
+{
+    if (arrlist == NULL) {
+        return NULL;
+    }
+
+    if (key_size != 1 && key_size != 2 && key_size != 4 && key_size != 8) {
+        return NULL;
+    }
+
+    _choco_arraylist_header* header = _choco_arraylist_get_header(arrlist);
+    _allocator allocator = header->allocator;
+    if (!_is_allocator_valid(allocator) || key_offset + key_size > header->size) {
+        return NULL;
+    }
+
+    _source source = {
+        .data = arrlist,
+        .stride = header->size,
+        .key_offset = key_offset,
+        .key_size = key_size
+    };
+
+    for (size_t i = 1; i < header->used; i++) {
+        if (_read_key(&source, i - 1) > _read_key(&source, i)) {
+            return NULL;
+        }
+    }
+
+    // One block: the index, then the keys starting on a cache line, then the positions.
+    size_t slots = header->used + 1;
+    size_t keys_offset = _round_up(sizeof(_index), _CACHE_LINE) + _CACHE_LINE;
+    size_t indices_offset = keys_offset + _round_up(slots * sizeof(uint64_t), _CACHE_LINE);
+    size_t required_space = indices_offset + slots * sizeof(size_t);
+
+    _index* index = allocator.allocate(&allocator, required_space);
+    if (index == NULL) {
+        return NULL;
+    }
+
+    char* block = (char*)index;
+    char* keys = (char*)_round_up((uintptr_t)(block + keys_offset - _CACHE_LINE), _CACHE_LINE);
+    *index = (_index) {
+        .allocator = allocator,
+        .length = header->used,
+        .keys = (uint64_t*)keys,
+        .indices = (size_t*)(keys + (indices_offset - keys_offset)),
+    };
+
+    index->keys[0] = 0;
+    index->indices[0] = header->used;
+    _fill(index, &source, 0, 1);
+    return index;
+}
+
+_result _choco_search_index_destroy(_index* index)
+{
+    if (index == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _allocator allocator = index->allocator;
+    allocator.deallocate(&allocator, index);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+size_t _choco_search_index_lower_bound(const _index* index, uint64_t key)
+{
+    if (index == NULL) {
+        return 0;
+    }
+
+    size_t node = _descend(index, key);
+    return index->indices[node];
+}
+
+size_t _choco_search_index_lookup(const _index* index, uint64_t key)
+{
+    if (index == NULL) {
+        return 0;
+    }
+
+    size_t node = _descend(index, key);
+    return node != 0 && index->keys[node] == key ? index->indices[node] : index->length;
+}
+
+// Every lane runs for the height of the tree. A lane that fell off the tree keeps its node,
+// and reads `keys[0]` instead, so the step stays free of branches.
+void _choco_search_index_lookup_n(const _index* index, const uint64_t* keys, size_t count, size_t* positions)
+{
+    if (index == NULL || keys == NULL || positions == NULL) {
+        return;
+    }
+
+    size_t length = index->length;
+    const uint64_t* tree = index->keys;
+    size_t levels = length == 0 ? 0 : 64 - __builtin_clzll(length);
+
+    for (size_t base = 0; base < count; base += _BATCH) {
+        size_t lanes = count - base < _BATCH ? count - base : _BATCH;
+        size_t nodes[_BATCH];
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            nodes[lane] = 1;
+        }
+
+        for (size_t level = 0; level < levels; level++) {
+            for (size_t lane = 0; lane < lanes; lane++) {
+                size_t k = nodes[lane];
+                int inside = k <= length;
+                uint64_t pivot = tree[inside ? k : 0];
+                __builtin_prefetch(tree + 16 * k);
+                nodes[lane] = inside ? 2 * k + (pivot < keys[base + lane]) : k;
+            }
+        }
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            size_t node = _lower_bound_node(nodes[lane]);
+            positions[base + lane] = node != 0 && tree[node] == keys[base + lane] ? index->indices[node] : length;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Read-only copy of the keys of a sorted arraylist, stored in Eytzinger (BFS) order: node `k`
+// has its children at `2k` and `2k + 1`, so the first levels of every search share the same
+// cache lines. `keys` and `indices` are 1-based; `indices[k]` is the position of `keys[k]` in
+// the original list.
+typedef struct _choco_search_index {
+    _choco_arraylist_allocator allocator;
+    size_t length;
+    uint64_t* keys;
+    size_t* indices;
+} _choco_search_index;
+
+// Keys are unsigned integers of 1, 2, 4 or 8 bytes found at `key_offset` in every element. The
+// list must be sorted by key; NULL is returned otherwise.
+_choco_search_index* _choco_search_index_build(_choco_arraylist arrlist, size_t key_offset, size_t key_size);
+_choco_arraylist_result _choco_search_index_destroy(_choco_search_index* index);
+
+// Both return a position in the original list, or the length of the list when not found.
+size_t _choco_search_index_lower_bound(const _choco_search_index* index, uint64_t key);
+size_t _choco_search_index_lookup(const _choco_search_index* index, uint64_t key);
+
+// Looks up `count` keys, interleaving several searches so their cache misses overlap.
+void _choco_search_index_lookup_n(const _choco_search_index* index, const uint64_t* keys, size_t count, size_t* positions);
+
+#ifdef __cplusplus
+}
+#endif
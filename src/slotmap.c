@@ -0,0 +1,212 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "slotmap.h"
+
+typedef _choco_slotmap _map;
+typedef _choco_slotmap_slot _slot;
+typedef _choco_slotmap_handle _handle;
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_allocator _allocator;
+
+#define _NO_SLOT (UINT32_MAX)
+
+#define _is_allocator_valid(allocator) \
+    (allocator.allocate != NULL && allocator.deallocate != NULL)
+
+#define _make_handle(index, generation) \
+    (((_handle)(generation) << 32) | (index))
+
+#define _handle_index(handle) \
+    ((uint32_t)(handle))
+
+#define _handle_generation(handle) \
+    ((uint32_t)((handle) >> 32))
+
+#define _is_used(slot) \
+    (((slot)->generation & 1) != 0)
+
+#define _get_slot(map, index) \
+    (((_slot*)(map)->slots) + (index))
+
+#define _get_owner(map, index) \
+    (((uint32_t*)(map)->owners) + (index))
+
+static _slot* _find(const _map* map, _handle handle)
+{
+    uint32_t index = _handle_index(handle);
+    if (index >= _choco_arraylist_length(map->slots)) {
+        return NULL;
+    }
+
+    _slot* slot = _get_slot(map, index);
+    return _is_used(slot) && slot->generation == _handle_generation(handle) ? slot : NULL;
+}
+
+// Appends one element to a list of the map; false when it could not grow.
+static int _grow(_choco_arraylist* list)
+{
+    size_t length = _choco_arraylist_length(*list);
+    *list = _choco_arraylist_add(*list);
+    return _choco_arraylist_length(*list) == length + 1;
+}
+
+_map* _choco_slotmap_create(_allocator allocator, size_t size, size_t capacity)
+{
+    if (!_is_allocator_valid(allocator) || size == 0) {
+        return NULL;
+    }
+
+    _map* map = allocator.allocate(&allocator, sizeof(_map));
+    if (map == NULL) {
+        return NULL;
+    }
+
+    *map = (_map) {
+        .allocator = allocator,
+        .values = _choco_arraylist_create(allocator, size, capacity),
+        .owners = _choco_arraylist_create(allocator, sizeof(uint32_t), capacity),
+        .slots = _choco_arraylist_create(allocator, sizeof(_slot), capacity),
+        .free_head = _NO_SLOT,
+    };
+
+    if (map->values == NULL || map->owners == NULL || map->slots == NULL) {
+        _choco_slotmap_destroy(map);
+        return NULL;
+    }
+    return map;
+}
+
+_result _choco_slotmap_destroy(_map* map)
+{
+    if (map == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _allocator allocator = map->allocator;
+    _choco_arraylist_destroy(map->values);
+    _choco_arraylist_destroy(map->owners);
+    _choco_arraylist_destroy(map->slots);
+    allocator.deallocate(&allocator, map);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+void* _choco_slotmap_insert(_map* map, _handle* handle)
+{
+    if (map == NULL || handle == NULL) {
+        return NULL;
+    }
+
+    size_t dense = _choco_arraylist_length(map->values);
+    uint32_t index = map->free_head;
+
+    if (index == _NO_SLOT) {
+        size_t length = _choco_arraylist_length(map->slots);
+        if (length >= _NO_SLOT || !_grow(&map->slots)) {
+            return NULL;
+        }
+
+        index = (uint32_t)length;
+        *_get_slot(map, index) = (_slot) { .index = _NO_SLOT, .generation = 0 };
+        map->free_head = index;
+    }
+
+    if (!_grow(&map->values)) {
+        return NULL;
+    }
+
+    if (!_grow(&map->owners)) {
+        _choco_arraylist_remove(&map->values);
+        return NULL;
+    }
+
+    _slot* slot = _get_slot(map, index);
+    map->free_head = slot->index;
+    slot->index = (uint32_t)dense;
+    slot->generation++;
+    *_get_owner(map, dense) = index;
+
+    *handle = _make_handle(index, slot->generation);
+    return _choco_arraylist_at(map->values, dense);
+}
+
+// The last element moves into the hole, so the elements stay contiguous.
+_result _choco_slotmap_erase(_map* map, _handle handle)
+{
+    if (map == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    _slot* slot = _find(map, handle);
+    if (slot == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    size_t dense = slot->index;
+    size_t last = _choco_arraylist_length(map->values) - 1;
+
+    if (dense != last) {
+        size_t size = _choco_arraylist_element_size(map->values);
+        memcpy(_choco_arraylist_at(map->values, dense), _choco_arraylist_at(map->values, last), size);
+
+        uint32_t moved = *_get_owner(map, last);
+        *_get_owner(map, dense) = moved;
+        _get_slot(map, moved)->index = (uint32_t)dense;
+    }
+
+    _choco_arraylist_remove(&map->values);
+    _choco_arraylist_remove(&map->owners);
+
+    slot->generation++;
+    slot->index = map->free_head;
+    map->free_head = _handle_index(handle);
+    return _CHOCO_ARRAYLIST_RESULT_OK;
+}
+
+void* _choco_slotmap_get(const _map* map, _handle handle)
+{
+    if (map == NULL) {
+        return NULL;
+    }
+
+    _slot* slot = _find(map, handle);
+    return slot == NULL ? NULL : _choco_arraylist_at(map->values, slot->index);
+}
+
+_result _choco_slotmap_contains(const _map* map, _handle handle)
+{
+    if (map == NULL) {
+        return _CHOCO_ARRAYLIST_RESULT_ERROR;
+    }
+
+    return _find(map, handle) != NULL ? _CHOCO_ARRAYLIST_RESULT_YES : _CHOCO_ARRAYLIST_RESULT_NO;
+}
+
+_choco_arraylist _choco_slotmap_values(const _map* map)
+{
+    if (map == NULL) {
+        return NULL;
+    }
+
+    return map->values;
+}
+
+_handle _choco_slotmap_handle_at(const _map* map, size_t index)
+{
+    if (map == NULL || index >= _choco_arraylist_length(map->values)) {
+        return _CHOCO_SLOTMAP_NULL;
+    }
+
+    uint32_t owner = *_get_owner(map, index);
+    return _make_handle(owner, _get_slot(map, owner)->generation);
+}
+
+size_t _choco_slotmap_length(const _map* map)
+{
+    if (map == NULL) {
+        return 0;
+    }
+
+    return _choco_arraylist_length(map->values);
+}
@@ -0,0 +1,56 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Slot index in the low 32 bits, generation of the slot in the high 32 bits. A handle goes
+// stale once its element is erased, even when the slot is reused. No handle is ever equal to
+// `_CHOCO_SLOTMAP_NULL`.
+typedef uint64_t _choco_slotmap_handle;
+
+#define _CHOCO_SLOTMAP_NULL ((_choco_slotmap_handle)0)
+
+// `index` is the position of the element in `values` while the slot is used, and the next
+// free slot otherwise. The generation is odd while the slot is used.
+typedef struct _choco_slotmap_slot {
+    uint32_t index;
+    uint32_t generation;
+} _choco_slotmap_slot;
+
+// Elements are kept contiguous in `values`, in no particular order; `owners` holds the slot of
+// every element, so that erasing can move the last element into the hole.
+typedef struct _choco_slotmap {
+    _choco_arraylist_allocator allocator;
+    _choco_arraylist values;
+    _choco_arraylist owners;
+    _choco_arraylist slots;
+    uint32_t free_head;
+} _choco_slotmap;
+
+_choco_slotmap* _choco_slotmap_create(_choco_arraylist_allocator allocator, size_t size, size_t capacity);
+_choco_arraylist_result _choco_slotmap_destroy(_choco_slotmap* map);
+
+// Adds a zeroed element and returns it, or NULL when out of memory. Pointers to elements are
+// only valid until the next insert or erase.
+void* _choco_slotmap_insert(_choco_slotmap* map, _choco_slotmap_handle* handle);
+_choco_arraylist_result _choco_slotmap_erase(_choco_slotmap* map, _choco_slotmap_handle handle);
+
+// NULL for a stale handle.
+void* _choco_slotmap_get(const _choco_slotmap* map, _choco_slotmap_handle handle);
+_choco_arraylist_result _choco_slotmap_contains(const _choco_slotmap* map, _choco_slotmap_handle handle);
+
+// The elements, contiguous, for iteration; and the handle of the element at a position.
+_choco_arraylist _choco_slotmap_values(const _choco_slotmap* map);
+_choco_slotmap_handle _choco_slotmap_handle_at(const _choco_slotmap* map, size_t index);
+size_t _choco_slotmap_length(const _choco_slotmap* map);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,361 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "sortedset.h"
+#include "cpu.h"
+#include <immintrin.h>
+
+typedef _choco_arraylist_result _result;
+typedef _choco_arraylist_header _header;
+
+// Below this ratio between the sizes of the inputs, both are walked block by block; above it,
+// every element of the smaller one is searched in the larger one.
+#define _GALLOP_RATIO (32)
+
+#define _is_list_of(arrlist, type) \
+    (arrlist != NULL && _choco_arraylist_element_size(arrlist) == sizeof(type))
+
+#define _min(a, b) \
+    ((a) < (b) ? (a) : (b))
+
+// Makes room for `count` more elements of `*dst` without adding them, and returns where they
+// go, or NULL when the list could not grow.
+static void* _reserve(_choco_arraylist* dst, size_t count)
+{
+    _header* header = _choco_arraylist_get_header(*dst);
+    size_t used = header->used;
+
+    if (used + count > header->allocated) {
+        *dst = _choco_arraylist_resize(*dst, used + count);
+    } else {
+        *dst = _choco_arraylist_unshare(*dst);
+    }
+
+    header = _choco_arraylist_get_header(*dst);
+    if (used + count > header->allocated || _choco_arraylist_is_shared(*dst) == _CHOCO_ARRAYLIST_RESULT_YES) {
+        return NULL;
+    }
+    return (char*)*dst + used * header->size;
+}
+
+static void _commit(_choco_arraylist dst, size_t count)
+{
+    _choco_arraylist_get_header(dst)->used += count;
+}
+
+// All-pairs compare of a block of `a` against a block of `b`: the block of `b` is rotated one
+// lane at a time, and the lanes of `a` that matched accumulate in `found` until `a` moves on.
+// A block of `a` that stopped halfway is settled lane by lane before the scalar tail, since
+// its matched lanes are behind `b[j]`. The output never gets ahead of the input in `a`, so
+// `out` may be `a`.
+#define _define_block(suffix, type, lanes, vector_attributes, load, cmpeq, rotate, movemask) \
+    vector_attributes static size_t _block_##suffix(const type* a, size_t na, const type* b, size_t nb, type* out, int difference) \
+    {                                                                                         \
+        size_t i = 0, j = 0, n = 0;                                                           \
+        unsigned found = 0;                                                                   \
+        const unsigned all = (1u << lanes) - 1;                                               \
+                                                                                              \
+        while (i + lanes <= na && j + lanes <= nb) {                                          \
+            __m256i va = load(a + i);                                                         \
+            __m256i vb = load(b + j);                                                         \
+            __m256i equal = cmpeq(va, vb);                                                    \
+            for (int r = 1; r < lanes; r++) {                                                 \
+                vb = rotate(vb);                                                              \
+                equal = _mm256_or_si256(equal, cmpeq(va, vb));                                \
+            }                                                                                 \
+            found |= (unsigned)movemask(equal);                                               \
+                                                                                              \
+            type last_a = a[i + lanes - 1];                                                   \
+            type last_b = b[j + lanes - 1];                                                   \
+            if (last_a <= last_b) {                                                           \
+                n = _emit_##suffix(a + i, difference ? ~found & all : found, out, n);         \
+                found = 0;                                                                    \
+                i += lanes;                                                                   \
+            }                                                                                 \
+            if (last_b <= last_a) {                                                           \
+                j += lanes;                                                                   \
+            }                                                                                 \
+        }                                                                                     \
+                                                                                              \
+        if (found != 0) {                                                                     \
+            size_t settled = 0;                                                               \
+            while (settled < lanes && a[i + settled] <= b[j - 1]) {                           \
+                settled++;                                                                    \
+            }                                                                                 \
+            unsigned mask = (1u << settled) - 1;                                              \
+            n = _emit_##suffix(a + i, (difference ? ~found : found) & mask, out, n);          \
+            i += settled;                                                                     \
+        }                                                                                     \
+                                                                                              \
+        return n + _merge_##suffix(a + i, na - i, b + j, nb - j, out != NULL ? out + n : NULL, difference); \
+    }
+
+#define _define_sortedset(suffix, type)                                                       \
+    /* First index from `from` whose value is not below `key`: doubling steps, then a binary  \
+       search within the last step. */                                                        \
+    static size_t _lower_##suffix(const type* values, size_t from, size_t count, type key)    \
+    {                                                                                         \
+        size_t low = from, high = from, step = 1;                                             \
+        while (high < count && values[high] < key) {                                          \
+            low = high + 1;                                                                   \
+            high += step;                                                                     \
+            step *= 2;                                                                        \
+        }                                                                                     \
+                                                                                              \
+        high = _min(high, count);                                                             \
+        while (low < high) {                                                                  \
+            size_t middle = low + (high - low) / 2;                                           \
+            if (values[middle] < key) {                                                       \
+                low = middle + 1;                                                             \
+            } else {                                                                          \
+                high = middle;                                                                \
+            }                                                                                 \
+        }                                                                                     \
+        return low;                                                                           \
+    }                                                                                         \
+                                                                                              \
+    static size_t _emit_##suffix(const type* block, unsigned mask, type* out, size_t n)       \
+    {                                                                                         \
+        if (out == NULL) {                                                                    \
+            return n + (size_t)__builtin_popcount(mask);                                      \
+        }                                                                                     \
+                                                                                              \
+        for (; mask != 0; mask &= mask - 1) {                                                 \
+            out[n++] = block[__builtin_ctz(mask)];                                            \
+        }                                                                                     \
+        return n;                                                                             \
+    }                                                                                         \
+                                                                                              \
+    /* Branchless merge: elements of `a` found in `b`, or not found for a difference. */      \
+    static size_t _merge_##suffix(const type* a, size_t na, const type* b, size_t nb, type* out, int difference) \
+    {                                                                                         \
+        size_t i = 0, j = 0, n = 0;                                                           \
+        if (out == NULL) {                                                                    \
+            while (i < na && j < nb) {                                                        \
+                type x = a[i], y = b[j];                                                      \
+                n += x == y;                                                                  \
+                i += x <= y;                                                                  \
+                j += y <= x;                                                                  \
+            }                                                                                 \
+            return n;                                                                         \
+        }                                                                                     \
+                                                                                              \
+        while (i < na && j < nb) {                                                            \
+            type x = a[i], y = b[j];                                                          \
+            out[n] = x;                                                                       \
+            n += difference ? x < y : x == y;                                                 \
+            i += x <= y;                                                                      \
+            j += y <= x;                                                                      \
+        }                                                                                     \
+                                                                                              \
+        if (difference) {                                                                     \
+            memmove(out + n, a + i, (na - i) * sizeof(type));                                 \
+            n += na - i;                                                                      \
+        }                                                                                     \
+        return n;                                                                             \
+    }                                                                                         \
+                                                                                              \
+    /* Searches every element of `a` in `b`, which is much larger. */                         \
+    static size_t _gallop_##suffix(const type* a, size_t na, const type* b, size_t nb, type* out, int difference) \
+    {                                                                                         \
+        size_t n = 0, j = 0;                                                                  \
+        for (size_t i = 0; i < na; i++) {                                                     \
+            j = _lower_##suffix(b, j, nb, a[i]);                                              \
+            int present = j < nb && b[j] == a[i];                                             \
+            if (present != difference) {                                                      \
+                if (out != NULL) {                                                            \
+                    out[n] = a[i];                                                            \
+                }                                                                             \
+                n++;                                                                          \
+            }                                                                                 \
+        }                                                                                     \
+        return n;                                                                             \
+    }                                                                                         \
+                                                                                              \
+    /* Searches every element of `b`, which is much smaller, in `a`, and copies the runs of   \
+       `a` in between: either the matches for an intersection, or the runs for a difference. */ \
+    static size_t _skip_##suffix(const type* a, size_t na, const type* b, size_t nb, type* out, int difference) \
+    {                                                                                         \
+        size_t n = 0, i = 0;                                                                  \
+        for (size_t j = 0; j < nb && i < na; j++) {                                           \
+            size_t next = _lower_##suffix(a, i, na, b[j]);                                    \
+            if (difference) {                                                                 \
+                memmove(out + n, a + i, (next - i) * sizeof(type));                           \
+                n += next - i;                                                                \
+            }                                                                                 \
+            i = next;                                                                         \
+            if (i < na && a[i] == b[j]) {                                                     \
+                if (!difference && out != NULL) {                                             \
+                    out[n] = a[i];                                                            \
+                }                                                                             \
+                n += !difference;                                                             \
+                i++;                                                                          \
+            }                                                                                 \
+        }                                                                                     \
+                                                                                              \
+        if (difference) {                                                                     \
+            memmove(out + n, a + i, (na - i) * sizeof(type));                                 \
+            n += na - i;                                                                      \
+        }                                                                                     \
+        return n;                                                                             \
+    }                                                                                         \
+                                                                                              \
+    static size_t _block_##suffix(const type* a, size_t na, const type* b, size_t nb, type* out, int difference); \
+                                                                                              \
+    /* Picks the kernel from the sizes of the inputs. Elements are always taken from `a`,     \
+       or from `b` where they are equal, so `out` may be `a`. */                              \
+    static size_t _combine_##suffix(const type* a, size_t na, const type* b, size_t nb, type* out, int difference) \
+    {                                                                                         \
+        if (na / _GALLOP_RATIO > nb) {                                                        \
+            return _skip_##suffix(a, na, b, nb, out, difference);                             \
+        }                                                                                     \
+        if (nb / _GALLOP_RATIO > na) {                                                        \
+            return _gallop_##suffix(a, na, b, nb, out, difference);                           \
+        }                                                                                     \
+        if (_choco_cpu_features() & _CHOCO_CPU_AVX2) {                                        \
+            return _block_##suffix(a, na, b, nb, out, difference);                            \
+        }                                                                                     \
+        return _merge_##suffix(a, na, b, nb, out, difference);                                \
+    }                                                                                         \
+                                                                                              \
+    static size_t _union_##suffix(const type* a, size_t na, const type* b, size_t nb, type* out) \
+    {                                                                                         \
+        size_t i = 0, j = 0, n = 0;                                                           \
+        if (na / _GALLOP_RATIO > nb || nb / _GALLOP_RATIO > na) {                             \
+            /* Copies the runs of the larger input between the elements of the smaller one. */ \
+            const type* large = na > nb ? a : b;                                              \
+            const type* small = na > nb ? b : a;                                              \
+            size_t nl = na > nb ? na : nb;                                                    \
+            size_t ns = na > nb ? nb : na;                                                    \
+            for (size_t k = 0; k < ns; k++) {                                                 \
+                size_t next = _lower_##suffix(large, j, nl, small[k]);                        \
+                memcpy(out + n, large + j, (next - j) * sizeof(type));                        \
+                n += next - j;                                                                \
+                j = next + (next < nl && large[next] == small[k]);                            \
+                out[n++] = small[k];                                                          \
+            }                                                                                 \
+            memcpy(out + n, large + j, (nl - j) * sizeof(type));                              \
+            return n + nl - j;                                                                \
+        }                                                                                     \
+                                                                                              \
+        while (i < na && j < nb) {                                                            \
+            type x = a[i], y = b[j];                                                          \
+            out[n++] = x <= y ? x : y;                                                        \
+            i += x <= y;                                                                      \
+            j += y <= x;                                                                      \
+        }                                                                                     \
+        memcpy(out + n, a + i, (na - i) * sizeof(type));                                      \
+        n += na - i;                                                                          \
+        memcpy(out + n, b + j, (nb - j) * sizeof(type));                                      \
+        return n + nb - j;                                                                    \
+    }                                                                                         \
+                                                                                              \
+    _choco_arraylist _choco_sortedset_intersect_##suffix(_choco_arraylist dst, _choco_arraylist a, _choco_arraylist b) \
+    {                                                                                         \
+        if (!_is_list_of(dst, type) || !_is_list_of(a, type) || !_is_list_of(b, type) || dst == a || dst == b) { \
+            return dst;                                                                       \
+        }                                                                                     \
+                                                                                              \
+        size_t na = _choco_arraylist_length(a);                                               \
+        size_t nb = _choco_arraylist_length(b);                                               \
+        type* out = _reserve(&dst, _min(na, nb));                                             \
+        if (out != NULL) {                                                                    \
+            _commit(dst, _combine_##suffix(a, na, b, nb, out, 0));                            \
+        }                                                                                     \
+        return dst;                                                                           \
+    }                                                                                         \
+                                                                                              \
+    _choco_arraylist _choco_sortedset_union_##suffix(_choco_arraylist dst, _choco_arraylist a, _choco_arraylist b) \
+    {                                                                                         \
+        if (!_is_list_of(dst, type) || !_is_list_of(a, type) || !_is_list_of(b, type) || dst == a || dst == b) { \
+            return dst;                                                                       \
+        }                                                                                     \
+                                                                                              \
+        size_t na = _choco_arraylist_length(a);                                               \
+        size_t nb = _choco_arraylist_length(b);                                               \
+        type* out = _reserve(&dst, na + nb);                                                  \
+        if (out != NULL) {                                                                    \
+            _commit(dst, _union_##suffix(a, na, b, nb, out));                                 \
+        }                                                                                     \
+        return dst;                                                                           \
+    }                                                                                         \
+                                                                                              \
+    _choco_arraylist _choco_sortedset_difference_##suffix(_choco_arraylist dst, _choco_arraylist a, _choco_arraylist b) \
+    {                                                                                         \
+        if (!_is_list_of(dst, type) || !_is_list_of(a, type) || !_is_list_of(b, type) || dst == a || dst == b) { \
+            return dst;                                                                       \
+        }                                                                                     \
+                                                                                              \
+        size_t na = _choco_arraylist_length(a);                                               \
+        size_t nb = _choco_arraylist_length(b);                                               \
+        type* out = _reserve(&dst, na);                                                       \
+        if (out != NULL) {                                                                    \
+            _commit(dst, _combine_##suffix(a, na, b, nb, out, 1));                            \
+        }                                                                                     \
+        return dst;                                                                           \
+    }                                                                                         \
+                                                                                              \
+    size_t _choco_sortedset_intersect_count_##suffix(_choco_arraylist a, _choco_arraylist b)  \
+    {                                                                                         \
+        if (!_is_list_of(a, type) || !_is_list_of(b, type)) {                                 \
+            return 0;                                                                         \
+        }                                                                                     \
+                                                                                              \
+        return _combine_##suffix(a, _choco_arraylist_length(a), b, _choco_arraylist_length(b), NULL, 0); \
+    }                                                                                         \
+                                                                                              \
+    /* The smallest list is copied to `dst`, then intersected in place with the others, which \
+       are mostly galloped through once the result gets small. */                             \
+    _choco_arraylist _choco_sortedset_intersect_n_##suffix(_choco_arraylist dst, const _choco_arraylist* lists, size_t count) \
+    {                                                                                         \
+        if (!_is_list_of(dst, type) || lists == NULL || count == 0) {                         \
+            return dst;                                                                       \
+        }                                                                                     \
+                                                                                              \
+        size_t smallest = 0;                                                                  \
+        for (size_t k = 0; k < count; k++) {                                                  \
+            if (!_is_list_of(lists[k], type) || lists[k] == dst) {                            \
+                return dst;                                                                   \
+            }                                                                                 \
+            if (_choco_arraylist_length(lists[k]) < _choco_arraylist_length(lists[smallest])) { \
+                smallest = k;                                                                 \
+            }                                                                                 \
+        }                                                                                     \
+                                                                                              \
+        size_t n = _choco_arraylist_length(lists[smallest]);                                  \
+        type* out = _reserve(&dst, n);                                                        \
+        if (out == NULL) {                                                                    \
+            return dst;                                                                       \
+        }                                                                                     \
+                                                                                              \
+        memcpy(out, lists[smallest], n * sizeof(type));                                       \
+        for (size_t k = 0; k < count && n > 0; k++) {                                         \
+            if (k != smallest) {                                                              \
+                n = _combine_##suffix(out, n, lists[k], _choco_arraylist_length(lists[k]), out, 0); \
+            }                                                                                 \
+        }                                                                                     \
+        _commit(dst, n);                                                                      \
+        return dst;                                                                           \
+    }
+
+_define_sortedset(u32, uint32_t)
+_define_sortedset(u64, uint64_t)
+
+#define _load(pointer) \
+    _mm256_loadu_si256((const __m256i*)(pointer))
+
+#define _rotate_u32(vector) \
+    _mm256_permutevar8x32_epi32(vector, _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0))
+
+#define _rotate_u64(vector) \
+    _mm256_permute4x64_epi64(vector, 0x39)
+
+#define _movemask_u32(vector) \
+    _mm256_movemask_ps(_mm256_castsi256_ps(vector))
+
+#define _movemask_u64(vector) \
+    _mm256_movemask_pd(_mm256_castsi256_pd(vector))
+
+_define_block(u32, uint32_t, 8, __attribute__((target("avx2"))), _load, _mm256_cmpeq_epi32, _rotate_u32, _movemask_u32)
+_define_block(u64, uint64_t, 4, __attribute__((target("avx2"))), _load, _mm256_cmpeq_epi64, _rotate_u64, _movemask_u64)
@@ -0,0 +1,37 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include "arraylist.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Set operations over lists of unsigned integers sorted in increasing order without duplicates,
+// declared for every suffix below. Results for other lists are unspecified.
+//
+// The results are appended to `dst`, which grows at most once to the largest possible result;
+// reserving that much up front avoids the allocation. They return `dst`, left untouched when
+// the element sizes do not match or when `dst` is one of the inputs.
+//
+//   intersect        elements of both `a` and `b`
+//   union            elements of `a` or `b`
+//   difference       elements of `a` that are not in `b`
+//   intersect_count  size of the intersection, without writing it
+//   intersect_n      elements of all the `count` lists
+#define _choco_sortedset_declare(suffix)                                                                                   \
+    _choco_arraylist _choco_sortedset_intersect_##suffix(_choco_arraylist dst, _choco_arraylist a, _choco_arraylist b);  \
+    _choco_arraylist _choco_sortedset_union_##suffix(_choco_arraylist dst, _choco_arraylist a, _choco_arraylist b);      \
+    _choco_arraylist _choco_sortedset_difference_##suffix(_choco_arraylist dst, _choco_arraylist a, _choco_arraylist b); \
+    size_t _choco_sortedset_intersect_count_##suffix(_choco_arraylist a, _choco_arraylist b);                            \
+    _choco_arraylist _choco_sortedset_intersect_n_##suffix(_choco_arraylist dst, const _choco_arraylist* lists, size_t count);
+
+_choco_sortedset_declare(u32)
+_choco_sortedset_declare(u64)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,150 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#define _GNU_SOURCE
+#include "trace.h"
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef _CHOCO_TRACE_SDT
+// Placed in `.probes`, where tracers look for the semaphores named by the probe notes.
+#define _semaphore(name) unsigned short choco_##name##_semaphore __attribute__((section(".probes")))
+
+_semaphore(create);
+_semaphore(grow);
+_semaphore(resize);
+_semaphore(remove);
+_semaphore(destroy);
+#endif
+
+// Every slot carries a sequence number used as a seqlock: odd while the owner writes it,
+// `2 * (position + 1)` once event `position` is complete. Readers copy the slot and keep it
+// only if the sequence did not move.
+typedef struct _slot {
+    uint64_t sequence;
+    _choco_trace_event event;
+} _slot;
+
+typedef struct _ring {
+    struct _ring* next;
+    uint64_t head;
+    uint32_t thread;
+    _slot slots[_CHOCO_TRACE_RING_LENGTH];
+} _ring;
+
+static _ring* _rings = NULL;
+static __thread _ring* _local = NULL;
+
+static const char* _kind_names[] = {
+    [_CHOCO_TRACE_CREATE] = "create",
+    [_CHOCO_TRACE_GROW] = "grow",
+    [_CHOCO_TRACE_RESIZE] = "resize",
+    [_CHOCO_TRACE_REMOVE] = "remove",
+    [_CHOCO_TRACE_DESTROY] = "destroy",
+};
+
+// Rings are linked once and never freed, so that events of finished threads can be dumped.
+static _ring* _local_ring(void)
+{
+    if (_local != NULL) {
+        return _local;
+    }
+
+    _ring* ring = calloc(1, sizeof(_ring));
+    if (ring == NULL) {
+        return NULL;
+    }
+
+    ring->thread = (uint32_t)syscall(SYS_gettid);
+    ring->next = __atomic_load_n(&_rings, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&_rings, &ring->next, ring, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+
+    _local = ring;
+    return ring;
+}
+
+uint64_t _choco_trace_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+void _choco_trace_record(_choco_trace_kind kind, const void* list, size_t size, size_t old_capacity, size_t new_capacity, uint64_t duration)
+{
+    _ring* ring = _local_ring();
+    if (ring == NULL) {
+        return;
+    }
+
+    uint64_t position = ring->head;
+    _slot* slot = &ring->slots[position % _CHOCO_TRACE_RING_LENGTH];
+
+    __atomic_store_n(&slot->sequence, 2 * position + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->event = (_choco_trace_event) {
+        .timestamp = _choco_trace_now(),
+        .duration = duration,
+        .list = list,
+        .size = size,
+        .old_capacity = old_capacity,
+        .new_capacity = new_capacity,
+        .kind = kind,
+        .thread = ring->thread,
+    };
+    __atomic_store_n(&slot->sequence, 2 * (position + 1), __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->head, position + 1, __ATOMIC_RELEASE);
+}
+
+size_t _choco_trace_dump(_choco_trace_visitor visitor, void* context)
+{
+    if (visitor == NULL) {
+        return 0;
+    }
+
+    size_t visited = 0;
+    for (_ring* ring = __atomic_load_n(&_rings, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+        uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        uint64_t first = head > _CHOCO_TRACE_RING_LENGTH ? head - _CHOCO_TRACE_RING_LENGTH : 0;
+
+        for (uint64_t position = first; position < head; position++) {
+            _slot* slot = &ring->slots[position % _CHOCO_TRACE_RING_LENGTH];
+            uint64_t expected = 2 * (position + 1);
+
+            if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != expected) {
+                continue;
+            }
+
+            _choco_trace_event event = slot->event;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) != expected) {
+                continue;
+            }
+
+            visitor(&event, context);
+            visited++;
+        }
+    }
+    return visited;
+}
+
+static void _print_event(const _choco_trace_event* event, void* context)
+{
+    const char* kind = event->kind < sizeof(_kind_names) / sizeof(_kind_names[0]) ? _kind_names[event->kind] : "?";
+    fprintf(context, "%llu %u %-7s list=%p size=%zu capacity=%zu->%zu duration=%lluns\n",
+        (unsigned long long)event->timestamp, event->thread, kind, event->list, event->size,
+        event->old_capacity, event->new_capacity, (unsigned long long)event->duration);
+}
+
+size_t _choco_trace_print(FILE* file)
+{
+    if (file == NULL) {
+        return 0;
+    }
+
+    return _choco_trace_dump(_print_event, file);
+}
@@ -0,0 +1,106 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tracing of the arraylist hot paths is compiled in with -DCHOCO_TRACE. It then emits USDT
+// probes (provider `choco`) when <sys/sdt.h> is available, and records into per-thread ring
+// buffers otherwise or when -DCHOCO_TRACE_RING is also given. Without CHOCO_TRACE the probes
+// expand to nothing.
+
+typedef enum _choco_trace_kind {
+    _CHOCO_TRACE_CREATE,
+    _CHOCO_TRACE_GROW,
+    _CHOCO_TRACE_RESIZE,
+    _CHOCO_TRACE_REMOVE,
+    _CHOCO_TRACE_DESTROY,
+} _choco_trace_kind;
+
+typedef struct _choco_trace_event {
+    uint64_t timestamp; // CLOCK_MONOTONIC, in ns.
+    uint64_t duration; // ns.
+    const void* list;
+    size_t size;
+    size_t old_capacity;
+    size_t new_capacity;
+    uint32_t kind;
+    uint32_t thread;
+} _choco_trace_event;
+
+#define _CHOCO_TRACE_RING_LENGTH (4096)
+
+typedef void (*_choco_trace_visitor)(const _choco_trace_event* event, void* context);
+
+uint64_t _choco_trace_now(void);
+void _choco_trace_record(_choco_trace_kind kind, const void* list, size_t size, size_t old_capacity, size_t new_capacity, uint64_t duration);
+
+// Visits the events still held by the ring of every thread that recorded one, oldest first
+// within a thread. Safe to call while other threads record; events overwritten during the
+// visit are skipped. Returns the number of events visited.
+size_t _choco_trace_dump(_choco_trace_visitor visitor, void* context);
+size_t _choco_trace_print(FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(CHOCO_TRACE) && !defined(CHOCO_TRACE_RING) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+// Every probe gets a semaphore, which the kernel increments while a tracer is attached, so
+// that an unattached probe costs a load and a nop instead of two clock reads.
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+#define _CHOCO_TRACE_SDT
+
+extern unsigned short choco_create_semaphore;
+extern unsigned short choco_grow_semaphore;
+extern unsigned short choco_resize_semaphore;
+extern unsigned short choco_remove_semaphore;
+extern unsigned short choco_destroy_semaphore;
+#endif
+#endif
+
+// `probe` names the event that `start` times, which the USDT probes need to skip the timing.
+#if !defined(CHOCO_TRACE)
+#define _choco_trace_start(probe, start)
+#define _choco_trace_emit(probe, kind, list, size, old_capacity, new_capacity, start) \
+    ((void)sizeof(list), (void)sizeof(size), (void)sizeof(old_capacity), (void)sizeof(new_capacity))
+#elif defined(_CHOCO_TRACE_SDT)
+#define _choco_trace_enabled(probe) __builtin_expect(choco_##probe##_semaphore, 0)
+#define _choco_trace_start(probe, start) uint64_t start = _choco_trace_enabled(probe) ? _choco_trace_now() : 0
+/* A tracer attached after `start` was taken gets a duration of 0 for that event. */
+#define _choco_trace_emit(probe, kind, list, size, old_capacity, new_capacity, start)                               \
+    do {                                                                                                          \
+        if (_choco_trace_enabled(probe)) {                                                                        \
+            uint64_t _duration = (start) != 0 ? _choco_trace_now() - (start) : 0;                                 \
+            STAP_PROBE5(choco, probe, list, size, old_capacity, new_capacity, _duration);                         \
+        }                                                                                                         \
+    } while (0)
+#else
+#define _choco_trace_start(probe, start) uint64_t start = _choco_trace_now()
+#define _choco_trace_emit(probe, kind, list, size, old_capacity, new_capacity, start) \
+    _choco_trace_record(kind, list, size, old_capacity, new_capacity, _choco_trace_now() - (start))
+#endif
+
+#define _choco_trace_create(list, size, capacity, start) \
+    _choco_trace_emit(create, _CHOCO_TRACE_CREATE, list, size, 0, capacity, start)
+
+#define _choco_trace_grow(list, size, old_capacity, new_capacity, start) \
+    _choco_trace_emit(grow, _CHOCO_TRACE_GROW, list, size, old_capacity, new_capacity, start)
+
+#define _choco_trace_resize(list, size, old_capacity, new_capacity, start) \
+    _choco_trace_emit(resize, _CHOCO_TRACE_RESIZE, list, size, old_capacity, new_capacity, start)
+
+#define _choco_trace_remove(list, size, capacity, start) \
+    _choco_trace_emit(remove, _CHOCO_TRACE_REMOVE, list, size, capacity, capacity, start)
+
+#define _choco_trace_destroy(list, size, capacity, start) \
+    _choco_trace_emit(destroy, _CHOCO_TRACE_DESTROY, list, size, capacity, 0, start)
@@ -5,5 +5,19 @@
 if [ ! -d "./out" ]; then
     mkdir ./out
 fi
-gcc -o ./out/choco_test -Werror -Wreturn-type -ggdb $(find ./src -name '*.c' -print) $(find ./tests -name '*.c' -print) -I/usr/include -L/usr/lib -static-libgcc
+
+# C++ tests are compiled apart, since the flags differ. The parallel algorithms of libstdc++
+# run on TBB when its headers are installed, and then need the library.
+CXX_OBJECTS=""
+CXX_LIBS="-lstdc++"
+if echo '#include <tbb/tbb.h>' | g++ -x c++ -E - > /dev/null 2>&1; then
+    CXX_LIBS="${CXX_LIBS} -ltbb"
+fi
+for source in $(find ./tests -name '*.cpp' -print); do
+    object="./out/$(basename "${source}" .cpp)_cpp.o"
+    g++ -std=c++20 -c -o "${object}" ${CXXFLAGS} -Werror -Wreturn-type -ggdb "${source}" || exit 1
+    CXX_OBJECTS="${CXX_OBJECTS} ${object}"
+done
+
+gcc -o ./out/choco_test ${CFLAGS} -Werror -Wreturn-type -ggdb $(find ./src -name '*.c' -print) $(find ./tests -name '*.c' -print) ${CXX_OBJECTS} -I/usr/include -L/usr/lib -static-libgcc ${CXX_LIBS}
 chmod +x ./out/choco_test
@@ -2,4 +2,4 @@
 # Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
 #
 
-./out/choco_test
\ No newline at end of file
+./out/choco_test "$@"
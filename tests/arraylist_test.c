@@ -2,24 +2,20 @@
     Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
 */
 
-#include "arraylist_test.h"
 #include "../src/arraylist.h"
+#include "../src/gt/test.h"
+#include <pthread.h>
 
-// Packing struct to avoid failing tests because of automatic padding. When created with
-// `_choco_arraylist_create_x`, the arraylist is dynamically allocated with a packed alignment.
-//
-// Source : https://www.ibm.com/docs/fr/xl-c-and-cpp-aix/16.1.0?topic=descriptions-pragma-pack
-//
-
-#pragma push
-#pragma pack(1)
+// The header is aligned on `max_align_t`, and its size is a multiple of that alignment, so
+// `data` follows it without padding, exactly like a list created with `_choco_arraylist_create`.
+// Only the trailing padding of the mock differs, so sizes are computed from its members.
 #define _MOCK_DATA_LENGTH (10)
+#define _MOCK_SIZE (sizeof(_choco_arraylist_header) + sizeof(int) * _MOCK_DATA_LENGTH)
 typedef struct _mock _mock;
 struct _mock {
     _choco_arraylist_header header;
     int data[_MOCK_DATA_LENGTH];
 };
-#pragma pop
 
 static struct _memmgr {
     _mock mocks[10];
@@ -47,6 +43,7 @@ static void init_new_mock(_mock* mock, size_t allocated, size_t used, _choco_arr
     mock->header.allocated = allocated;
     mock->header.size = sizeof(int);
     mock->header.used = used;
+    mock->header.refs = 1;
 }
 
 static void mock_dealloc(void* self, void* ptr)
@@ -64,7 +61,7 @@ static void mock_dealloc(void* self, void* ptr)
 
 static void* mock_alloc(void* self, size_t size)
 {
-    const static size_t max_size = sizeof(_mock);
+    const static size_t max_size = _MOCK_SIZE;
     const static size_t memmgr_count = sizeof(mock_memmgr.mocks) / sizeof(mock_memmgr.mocks[0]);
     void* ptr_returned = NULL;
 
@@ -190,7 +187,7 @@ _gt_test(_choco_arraylist_sizeof, )
     size_t physical_size = _choco_arraylist_sizeof(mock.data);
 
     // assert
-    _gt_test_int_eq(physical_size, sizeof(mock_arrlist));
+    _gt_test_int_eq(physical_size, _MOCK_SIZE);
     _gt_passed();
 }
 
@@ -225,9 +222,10 @@ _gt_test(_choco_arraylist_swap, )
     init_new_mock(&mock, 10, used, init_new_allocator());
     int valueA = mock.data[indexA];
     int valueB = mock.data[indexB];
+    _choco_arraylist arrlist = mock.data;
 
     // act
-    _choco_arraylist_result result = _choco_arraylist_swap(mock.data, indexA, indexB);
+    _choco_arraylist_result result = _choco_arraylist_swap(&arrlist, indexA, indexB);
 
     // assert
     _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
@@ -245,9 +243,10 @@ _gt_test(_choco_arraylist_swap, invalid_index)
     _mock mock;
     init_new_mock(&mock, 10, used, init_new_allocator());
     int valueA = mock.data[indexA];
+    _choco_arraylist arrlist = mock.data;
 
     // act
-    _choco_arraylist_result result = _choco_arraylist_swap(mock_arrlist.data, indexA, indexB);
+    _choco_arraylist_result result = _choco_arraylist_swap(&arrlist, indexA, indexB);
 
     // assert
     _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
@@ -261,9 +260,10 @@ _gt_test(_choco_arraylist_remove, )
     size_t used = 4;
     _mock mock;
     init_new_mock(&mock, 10, used, init_new_allocator());
+    _choco_arraylist arrlist = mock.data;
 
     // act
-    _choco_arraylist_remove(mock.data);
+    _choco_arraylist_remove(&arrlist);
 
     // assert
     _gt_test_int_eq(mock.header.used, used - 1);
@@ -276,9 +276,10 @@ _gt_test(_choco_arraylist_remove, when_empty)
     size_t used = 0;
     _mock mock;
     init_new_mock(&mock, 10, used, init_new_allocator());
+    _choco_arraylist arrlist = mock.data;
 
     // act
-    _choco_arraylist_remove(mock.data);
+    _choco_arraylist_remove(&arrlist);
 
     // assert
     _gt_test_int_eq(mock.header.used, 0);
@@ -366,6 +367,31 @@ _gt_test(_choco_arraylist_resize, )
     _gt_passed();
 }
 
+_gt_test(_choco_arraylist_resize, keeps_content)
+{
+    // arrange
+    const size_t desired = 5;
+    const size_t size = sizeof(int);
+
+    init_mock_memmgr();
+    _choco_arraylist_allocator allocator = init_new_allocator();
+    _choco_arraylist arrlist = _choco_arraylist_create(allocator, size, 2);
+    arrlist = _choco_arraylist_add(arrlist);
+    arrlist = _choco_arraylist_add(arrlist);
+    *(int*)_choco_arraylist_at(arrlist, 0) = 42;
+    *(int*)_choco_arraylist_at(arrlist, 1) = 43;
+
+    // act
+    _choco_arraylist result = _choco_arraylist_resize(arrlist, desired);
+
+    // assert
+    _gt_test_ptr_neq(result, arrlist);
+    _gt_test_int_eq(_choco_arraylist_length(result), 2);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(result, 0), 42);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(result, 1), 43);
+    _gt_passed();
+}
+
 _gt_test(_choco_arraylist_resize, mem_alloc_failed)
 {
     // arrange
@@ -509,26 +535,463 @@ _gt_test(_choco_arraylist_add, alloc_fail)
     _gt_passed();
 }
 
-void _choco_arraylist_test(void)
-{
-    _gt_run(_choco_arraylist_get_header, );
-    _gt_run(_choco_arraylist_length, );
-    _gt_run(_choco_arraylist_element_size, );
-    _gt_run(_choco_arraylist_sizeof, );
-    _gt_run(_choco_arraylist_at, );
-    _gt_run(_choco_arraylist_swap, );
-    _gt_run(_choco_arraylist_swap, invalid_index);
-    _gt_run(_choco_arraylist_remove, );
-    _gt_run(_choco_arraylist_remove, when_empty);
-    _gt_run(_choco_arraylist_create, );
-    _gt_run(_choco_arraylist_create, invalid_allocator);
-    _gt_run(_choco_arraylist_create, mem_alloc_failed);
-    _gt_run(_choco_arraylist_resize, );
-    _gt_run(_choco_arraylist_resize, mem_alloc_failed);
-    _gt_run(_choco_arraylist_resize, alloc_invalid);
-    _gt_run(_choco_arraylist_is_full, no);
-    _gt_run(_choco_arraylist_is_full, yes);
-    _gt_run(_choco_arraylist_add, );
-    _gt_run(_choco_arraylist_add, when_full);
-    _gt_run(_choco_arraylist_add, alloc_fail);
+_gt_test(_choco_arraylist_destroy, )
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist_allocator allocator = init_new_allocator();
+    _choco_arraylist arrlist = _choco_arraylist_create(allocator, sizeof(int), 3);
+    _choco_arraylist_header* header = _choco_arraylist_get_header(arrlist);
+
+    // act
+    _choco_arraylist_result result = _choco_arraylist_destroy(arrlist);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_ptr_eq(mock_memmgr.d_last_ptr, header);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_destroy, clears_only_header)
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 3);
+    arrlist = _choco_arraylist_add(arrlist);
+    *(int*)_choco_arraylist_at(arrlist, 0) = 7;
+    _mock* mock = (_mock*)_choco_arraylist_get_header(arrlist);
+
+    // act
+    _choco_arraylist_destroy(arrlist);
+
+    // assert
+    _gt_test_int_eq(mock->header.used, 0);
+    _gt_test_ptr_eq(mock->header.data, NULL);
+    _gt_test_int_eq(mock->data[0], 7);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_snapshot, )
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 4);
+    arrlist = _choco_arraylist_add(arrlist);
+    *(int*)_choco_arraylist_at(arrlist, 0) = 7;
+
+    // act
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(arrlist);
+
+    // assert
+    _gt_test_ptr_eq(snapshot, arrlist);
+    _gt_test_int_eq(_choco_arraylist_is_shared(arrlist), _CHOCO_ARRAYLIST_RESULT_YES);
+    _gt_passed();
+}
+
+static void* take_snapshots(void* arrlist)
+{
+    for (size_t i = 0; i < 1000; i++) {
+        _choco_arraylist_snapshot(arrlist);
+    }
+    return NULL;
+}
+
+_gt_test(_choco_arraylist_snapshot, concurrent)
+{
+    // arrange
+    pthread_t threads[4];
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(int), 4);
+    _choco_arraylist_header* header = _choco_arraylist_get_header(arrlist);
+    header->refs = 0;
+
+    // act
+    for (size_t i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, take_snapshots, arrlist);
+    }
+    for (size_t i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // assert
+    _gt_test_int_eq(header->refs, 4001);
+    header->refs = 1;
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_snapshot, copy_on_add)
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 4);
+    arrlist = _choco_arraylist_add(arrlist);
+    *(int*)_choco_arraylist_at(arrlist, 0) = 7;
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(arrlist);
+
+    // act
+    arrlist = _choco_arraylist_add(arrlist);
+    *(int*)_choco_arraylist_at(arrlist, 0) = 8;
+
+    // assert
+    _gt_test_ptr_neq(arrlist, snapshot);
+    _gt_test_int_eq(_choco_arraylist_length(snapshot), 1);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(snapshot, 0), 7);
+    _gt_test_int_eq(_choco_arraylist_length(arrlist), 2);
+    _gt_test_int_eq(_choco_arraylist_is_shared(arrlist), _CHOCO_ARRAYLIST_RESULT_NO);
+    _gt_test_int_eq(_choco_arraylist_is_shared(snapshot), _CHOCO_ARRAYLIST_RESULT_NO);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_snapshot, copy_on_remove)
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 4);
+    arrlist = _choco_arraylist_add(arrlist);
+    *(int*)_choco_arraylist_at(arrlist, 0) = 7;
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(arrlist);
+
+    // act
+    _choco_arraylist_result result = _choco_arraylist_remove(&arrlist);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_ptr_neq(arrlist, snapshot);
+    _gt_test_int_eq(_choco_arraylist_length(arrlist), 0);
+    _gt_test_int_eq(_choco_arraylist_length(snapshot), 1);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(snapshot, 0), 7);
+    _gt_test_int_eq(_choco_arraylist_is_shared(snapshot), _CHOCO_ARRAYLIST_RESULT_NO);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_at_writable, shared)
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 4);
+    arrlist = _choco_arraylist_add(arrlist);
+    *(int*)_choco_arraylist_at(arrlist, 0) = 7;
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(arrlist);
+
+    // act
+    int* element = _choco_arraylist_at_writable(&arrlist, 0);
+    *element = 8;
+
+    // assert
+    _gt_test_ptr_neq(arrlist, snapshot);
+    _gt_test_ptr_eq(element, _choco_arraylist_at(arrlist, 0));
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(arrlist, 0), 8);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(snapshot, 0), 7);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_at_writable, out_of_bounds)
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 4);
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(arrlist);
+
+    // act
+    void* element = _choco_arraylist_at_writable(&arrlist, 0);
+
+    // assert
+    _gt_test_ptr_eq(element, NULL);
+    _gt_test_ptr_eq(arrlist, snapshot);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_release, last_reference_frees)
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 4);
+    _choco_arraylist_header* header = _choco_arraylist_get_header(arrlist);
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(arrlist);
+
+    // act
+    _choco_arraylist_destroy(arrlist);
+    void* after_destroy = mock_memmgr.d_last_ptr;
+    _choco_arraylist_release(snapshot);
+
+    // assert
+    _gt_test_ptr_eq(after_destroy, NULL);
+    _gt_test_ptr_eq(mock_memmgr.d_last_ptr, header);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_unshare, )
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 4);
+    arrlist = _choco_arraylist_add(arrlist);
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(arrlist);
+
+    // act
+    _choco_arraylist unique = _choco_arraylist_unshare(arrlist);
+
+    // assert
+    _gt_test_ptr_neq(unique, snapshot);
+    _gt_test_int_eq(_choco_arraylist_length(unique), 1);
+    _gt_test_int_eq(_choco_arraylist_swap(&unique, 0, 0), _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_ptr_eq(_choco_arraylist_unshare(unique), unique);
+    _gt_passed();
+}
+
+static _choco_arraylist init_sequence(size_t size, size_t count)
+{
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), size, count);
+    for (size_t i = 0; i < count; i++) {
+        arrlist = _choco_arraylist_add(arrlist);
+        memset(_choco_arraylist_at(arrlist, i), (int)(i & 0x7f), size);
+    }
+    return arrlist;
+}
+
+// Checks that element `i` holds the bytes written for element `expected[i]` by `init_sequence`.
+static int holds_sequence(_choco_arraylist arrlist, const size_t* expected, size_t count)
+{
+    size_t size = _choco_arraylist_element_size(arrlist);
+    for (size_t i = 0; i < count; i++) {
+        unsigned char* element = _choco_arraylist_at(arrlist, i);
+        for (size_t b = 0; b < size; b++) {
+            if (element[b] != (expected[i] & 0x7f)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static const size_t element_sizes[] = { 1, 2, 3, 4, 8, 16, 32, 100 };
+#define _ELEMENT_SIZES_COUNT (sizeof(element_sizes) / sizeof(element_sizes[0]))
+
+_gt_test(_choco_arraylist_reverse, )
+{
+    // arrange
+    size_t count = 101;
+    size_t expected[101];
+    for (size_t i = 0; i < count; i++) {
+        expected[i] = count - 1 - i;
+    }
+
+    for (size_t s = 0; s < _ELEMENT_SIZES_COUNT; s++) {
+        _choco_arraylist arrlist = init_sequence(element_sizes[s], count);
+
+        // act
+        _choco_arraylist_result result = _choco_arraylist_reverse(&arrlist);
+
+        // assert
+        _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+        _gt_test_int_eq(holds_sequence(arrlist, expected, count), 1);
+        _choco_arraylist_destroy(arrlist);
+    }
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_rotate, )
+{
+    // arrange
+    size_t count = 50;
+    size_t shift = 73;
+    size_t expected[50];
+    for (size_t i = 0; i < count; i++) {
+        expected[i] = (i + shift) % count;
+    }
+
+    for (size_t s = 0; s < _ELEMENT_SIZES_COUNT; s++) {
+        _choco_arraylist arrlist = init_sequence(element_sizes[s], count);
+
+        // act
+        _choco_arraylist_result result = _choco_arraylist_rotate(&arrlist, shift);
+
+        // assert
+        _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+        _gt_test_int_eq(holds_sequence(arrlist, expected, count), 1);
+        _choco_arraylist_destroy(arrlist);
+    }
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_apply_permutation, )
+{
+    // arrange
+    size_t count = 97;
+    size_t indices[97];
+    for (size_t i = 0; i < count; i++) {
+        indices[i] = (i * 13 + 5) % count;
+    }
+
+    for (size_t s = 0; s < _ELEMENT_SIZES_COUNT; s++) {
+        _choco_arraylist arrlist = init_sequence(element_sizes[s], count);
+
+        // act
+        _choco_arraylist_result result = _choco_arraylist_apply_permutation(&arrlist, indices);
+
+        // assert
+        _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+        _gt_test_int_eq(holds_sequence(arrlist, indices, count), 1);
+        _choco_arraylist_destroy(arrlist);
+    }
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_apply_permutation, not_a_permutation)
+{
+    // arrange
+    size_t indices[4] = { 0, 2, 2, 1 };
+    size_t unchanged[4] = { 0, 1, 2, 3 };
+    _choco_arraylist arrlist = init_sequence(sizeof(int), 4);
+
+    // act
+    _choco_arraylist_result result = _choco_arraylist_apply_permutation(&arrlist, indices);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _gt_test_int_eq(holds_sequence(arrlist, unchanged, 4), 1);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_apply_permutation, scratch_from_heap)
+{
+    // arrange
+    size_t indices[5] = { 4, 3, 2, 1, 0 };
+    init_mock_memmgr();
+    _choco_arraylist arrlist = _choco_arraylist_create(init_new_allocator(), sizeof(int), 5);
+    arrlist = _choco_arraylist_add_n(arrlist, 5);
+    for (int i = 0; i < 5; i++) {
+        *(int*)_choco_arraylist_at(arrlist, i) = i;
+    }
+    mock_memmgr.a_last_req_size = 0;
+
+    // act
+    _choco_arraylist_result result = _choco_arraylist_apply_permutation(&arrlist, indices);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(mock_memmgr.a_last_req_size, 0);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(arrlist, 0), 4);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(arrlist, 4), 0);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_gather, )
+{
+    // arrange
+    size_t indices[5] = { 9, 0, 4, 4, 7 };
+
+    for (size_t s = 0; s < _ELEMENT_SIZES_COUNT; s++) {
+        _choco_arraylist src = init_sequence(element_sizes[s], 10);
+        _choco_arraylist dst = init_sequence(element_sizes[s], 5);
+
+        // act
+        _choco_arraylist_result result = _choco_arraylist_gather(&dst, src, indices, 5);
+
+        // assert
+        _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+        _gt_test_int_eq(holds_sequence(dst, indices, 5), 1);
+        _choco_arraylist_destroy(src);
+        _choco_arraylist_destroy(dst);
+    }
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_scatter, )
+{
+    // arrange
+    size_t indices[3] = { 4, 0, 2 };
+    size_t expected[5] = { 1, 1, 2, 3, 0 };
+
+    for (size_t s = 0; s < _ELEMENT_SIZES_COUNT; s++) {
+        _choco_arraylist src = init_sequence(element_sizes[s], 3);
+        _choco_arraylist dst = init_sequence(element_sizes[s], 5);
+
+        // act
+        _choco_arraylist_result result = _choco_arraylist_scatter(&dst, src, indices);
+
+        // assert
+        _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+        _gt_test_int_eq(holds_sequence(dst, expected, 5), 1);
+        _choco_arraylist_destroy(src);
+        _choco_arraylist_destroy(dst);
+    }
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_gather, index_out_of_range)
+{
+    // arrange
+    size_t indices[2] = { 1, 10 };
+    _choco_arraylist src = init_sequence(sizeof(int), 10);
+    _choco_arraylist dst = init_sequence(sizeof(int), 2);
+
+    // act
+    _choco_arraylist_result result = _choco_arraylist_gather(&dst, src, indices, 2);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_arraylist_destroy(src);
+    _choco_arraylist_destroy(dst);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_add_n, )
+{
+    // arrange
+    init_mock_memmgr();
+    _choco_arraylist initial = _choco_arraylist_create(init_new_allocator(), sizeof(int), 2);
+    initial = _choco_arraylist_add(initial);
+
+    // act
+    _choco_arraylist result = _choco_arraylist_add_n(initial, 5);
+
+    // assert
+    _choco_arraylist_header* header = _choco_arraylist_get_header(result);
+    _gt_test_ptr_neq(result, initial);
+    _gt_test_int_eq(header->used, 6);
+    _gt_test_int_eq(header->allocated, 6);
+    _gt_test_int_eq(*(int*)_choco_arraylist_at(result, 5), 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_serialize, )
+{
+    // arrange
+    size_t expected[6] = { 0, 1, 2, 3, 4, 5 };
+    _choco_arraylist arrlist = init_sequence(12, 6);
+    char buffer[256];
+
+    // act
+    size_t required = _choco_arraylist_serialize(arrlist, NULL, 0);
+    size_t written = _choco_arraylist_serialize(arrlist, buffer, sizeof(buffer));
+    _choco_arraylist copy = _choco_arraylist_deserialize(_choco_arraylist_heap_allocator(), buffer, written);
+
+    // assert
+    _gt_test_int_eq(required, sizeof(_choco_arraylist_image) + 6 * 12);
+    _gt_test_int_eq(written, required);
+    _gt_test_int_eq(_choco_arraylist_element_size(copy), 12);
+    _gt_test_int_eq(_choco_arraylist_length(copy), 6);
+    _gt_test_int_eq(holds_sequence(copy, expected, 6), 1);
+    _choco_arraylist_destroy(arrlist);
+    _choco_arraylist_destroy(copy);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_deserialize, truncated)
+{
+    // arrange
+    _choco_arraylist arrlist = init_sequence(sizeof(int), 4);
+    char buffer[64];
+    size_t written = _choco_arraylist_serialize(arrlist, buffer, sizeof(buffer));
+
+    // act
+    _choco_arraylist copy = _choco_arraylist_deserialize(_choco_arraylist_heap_allocator(), buffer, written - 1);
+
+    // assert
+    _gt_test_ptr_eq(copy, NULL);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
 }
@@ -0,0 +1,158 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/arraylist.hpp"
+#include "../src/gt/test.h"
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+
+// Fills `list` with `count` values in decreasing order.
+static void fill_descending(choco::arraylist<int>& list, int count)
+{
+    for (int i = count - 1; i >= 0; i--) {
+        list.push_back(i);
+    }
+}
+
+_gt_test(choco_arraylist, construct)
+{
+    // arrange
+    choco::arraylist<int> empty;
+
+    // act
+    choco::arraylist<int> list(4);
+
+    // assert
+    _gt_test_ptr_eq(empty.native(), nullptr);
+    _gt_test_int_eq(empty.size(), 0);
+    _gt_test_int_eq(empty.capacity(), 0);
+    _gt_test_ptr_neq(list.native(), nullptr);
+    _gt_test_int_eq(list.size(), 0);
+    _gt_test_int_eq(list.capacity(), 4);
+    _gt_passed();
+}
+
+_gt_test(choco_arraylist, push_back)
+{
+    // arrange
+    choco::arraylist<int> list(1);
+
+    // act
+    fill_descending(list, 1000);
+
+    // assert
+    _gt_test_int_eq(list.size(), 1000);
+    _gt_test_int_gte(list.capacity(), 1000);
+    _gt_test_int_eq(list.front(), 999);
+    _gt_test_int_eq(list.back(), 0);
+    _gt_test_int_eq(list[500], 499);
+    _gt_passed();
+}
+
+_gt_test(choco_arraylist, push_back_own_element)
+{
+    // arrange
+    choco::arraylist<int> list(2);
+    list.push_back(7);
+    list.push_back(8);
+
+    // act
+    list.push_back(list[0]);
+    list.emplace_back(list.back());
+
+    // assert
+    _gt_test_int_eq(list.size(), 4);
+    _gt_test_int_eq(list[2], 7);
+    _gt_test_int_eq(list[3], 7);
+    _gt_passed();
+}
+
+_gt_test(choco_arraylist, move)
+{
+    // arrange
+    choco::arraylist<int> list(2);
+    fill_descending(list, 10);
+    _choco_arraylist native = list.native();
+
+    // act
+    choco::arraylist<int> moved(std::move(list));
+    choco::arraylist<int> assigned;
+    assigned = std::move(moved);
+
+    // assert
+    _gt_test_ptr_eq(list.native(), nullptr);
+    _gt_test_ptr_eq(moved.native(), nullptr);
+    _gt_test_ptr_eq(assigned.native(), native);
+    _gt_test_int_eq(assigned.size(), 10);
+    _gt_passed();
+}
+
+_gt_test(choco_arraylist, adopt)
+{
+    // arrange
+    _choco_arraylist native = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(int), 4);
+    native = _choco_arraylist_add_n(native, 3);
+    *static_cast<int*>(_choco_arraylist_at(native, 2)) = 7;
+
+    // act
+    choco::arraylist<int> list = choco::arraylist<int>::adopt(native);
+    list.push_back(8);
+    _choco_arraylist released = list.release();
+
+    // assert
+    _gt_test_ptr_eq(list.native(), nullptr);
+    _gt_test_int_eq(_choco_arraylist_length(released), 4);
+    _gt_test_int_eq(*static_cast<int*>(_choco_arraylist_at(released, 2)), 7);
+    _gt_test_int_eq(*static_cast<int*>(_choco_arraylist_at(released, 3)), 8);
+    _choco_arraylist_destroy(released);
+    _gt_passed();
+}
+
+_gt_test(choco_arraylist, parallel_sort)
+{
+    // arrange
+    choco::arraylist<int> list(16);
+    fill_descending(list, 100000);
+
+    // act
+    std::sort(std::execution::par_unseq, list.begin(), list.end());
+
+    // assert
+    _gt_test_int_eq(std::is_sorted(list.cbegin(), list.cend()), 1);
+    _gt_test_int_eq(list.front(), 0);
+    _gt_test_int_eq(list.back(), 99999);
+    _gt_passed();
+}
+
+_gt_test(choco_arraylist, snapshot)
+{
+    // arrange
+    choco::arraylist<int> list(4);
+    fill_descending(list, 4);
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(list.native());
+
+    // act
+    std::sort(list.begin(), list.end());
+
+    // assert
+    _gt_test_int_eq(list.front(), 0);
+    _gt_test_int_eq(*static_cast<int*>(_choco_arraylist_at(snapshot, 0)), 3);
+    _choco_arraylist_release(snapshot);
+    _gt_passed();
+}
+
+_gt_test(choco_arraylist, alignment)
+{
+    // arrange
+    choco::arraylist<long double> list(1);
+
+    // act
+    list.push_back(1.5L);
+
+    // assert
+    _gt_test_int_eq(reinterpret_cast<uintptr_t>(list.data()) % alignof(long double), 0);
+    _gt_test_float_eq(static_cast<double>(list[0]), 1.5);
+    _gt_passed();
+}
@@ -1,8 +0,0 @@
-/*
-    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
-*/
-
-#pragma once
-#include "../src/gt/test.h"
-
-void _choco_arraylist_test(void);
@@ -0,0 +1,199 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/bitset.h"
+#include "../src/cpu.h"
+#include "../src/gt/test.h"
+
+static _choco_bitset init_pattern(size_t length, size_t step)
+{
+    _choco_bitset bitset = _choco_bitset_create(_choco_arraylist_heap_allocator(), length);
+    for (size_t i = 0; i < length; i += step) {
+        _choco_bitset_set(bitset, i, 1);
+    }
+    return bitset;
+}
+
+_gt_test(_choco_bitset_create, )
+{
+    // arrange
+    size_t length = 130;
+
+    // act
+    _choco_bitset bitset = _choco_bitset_create(_choco_arraylist_heap_allocator(), length);
+
+    // assert
+    _choco_bitset_header* header = _choco_bitset_get_header(bitset);
+    _gt_test_ptr_neq(bitset, NULL);
+    _gt_test_int_eq(header->used, length);
+    _gt_test_int_eq(header->allocated, 3);
+    _gt_test_int_eq(_choco_bitset_popcount(bitset), 0);
+    _choco_bitset_destroy(bitset);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_set, out_of_range)
+{
+    // arrange
+    _choco_bitset bitset = _choco_bitset_create(_choco_arraylist_heap_allocator(), 10);
+
+    // act
+    _choco_arraylist_result result = _choco_bitset_set(bitset, 10, 1);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _gt_test_int_eq(_choco_bitset_test(bitset, 10), _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_bitset_destroy(bitset);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_push, )
+{
+    // arrange
+    _choco_bitset bitset = _choco_bitset_create(_choco_arraylist_heap_allocator(), 0);
+
+    // act
+    for (size_t i = 0; i < 1000; i++) {
+        bitset = _choco_bitset_push(bitset, i % 3 == 0);
+    }
+
+    // assert
+    _gt_test_int_eq(_choco_bitset_length(bitset), 1000);
+    _gt_test_int_eq(_choco_bitset_popcount(bitset), 334);
+    _gt_test_int_eq(_choco_bitset_test(bitset, 999), _CHOCO_ARRAYLIST_RESULT_YES);
+    _gt_test_int_eq(_choco_bitset_test(bitset, 998), _CHOCO_ARRAYLIST_RESULT_NO);
+    _choco_bitset_destroy(bitset);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_resize, clears_dropped_bits)
+{
+    // arrange
+    _choco_bitset bitset = init_pattern(200, 1);
+
+    // act
+    bitset = _choco_bitset_resize(bitset, 70);
+    bitset = _choco_bitset_resize(bitset, 200);
+
+    // assert
+    _gt_test_int_eq(_choco_bitset_popcount(bitset), 70);
+    _gt_test_int_eq(_choco_bitset_test(bitset, 70), _CHOCO_ARRAYLIST_RESULT_NO);
+    _choco_bitset_destroy(bitset);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_find_first_set, )
+{
+    // arrange
+    _choco_bitset bitset = _choco_bitset_create(_choco_arraylist_heap_allocator(), 300);
+    _choco_bitset_set(bitset, 5, 1);
+    _choco_bitset_set(bitset, 260, 1);
+
+    // act
+    size_t first = _choco_bitset_find_first_set(bitset, 0);
+    size_t second = _choco_bitset_find_first_set(bitset, first + 1);
+    size_t none = _choco_bitset_find_first_set(bitset, second + 1);
+
+    // assert
+    _gt_test_int_eq(first, 5);
+    _gt_test_int_eq(second, 260);
+    _gt_test_int_eq(none, 300);
+    _choco_bitset_destroy(bitset);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_rank, )
+{
+    // arrange
+    _choco_bitset bitset = init_pattern(1000, 3);
+
+    // act
+    size_t rank = _choco_bitset_rank(bitset, 100);
+
+    // assert
+    _gt_test_int_eq(rank, 34);
+    _gt_test_int_eq(_choco_bitset_rank(bitset, 5000), 334);
+    _choco_bitset_destroy(bitset);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_select, )
+{
+    // arrange
+    _choco_bitset bitset = init_pattern(1000, 3);
+
+    // act
+    size_t index = _choco_bitset_select(bitset, 40);
+
+    // assert
+    _gt_test_int_eq(index, 120);
+    _gt_test_int_eq(_choco_bitset_rank(bitset, index), 40);
+    _gt_test_int_eq(_choco_bitset_select(bitset, 334), 1000);
+    _choco_bitset_destroy(bitset);
+    _gt_passed();
+}
+
+// Counts after `and`, `or`, `xor` and `andnot` of the multiples of 2 with the multiples of 3.
+static void run_bulk_ops(size_t counts[4])
+{
+    _choco_bitset b = init_pattern(1001, 3);
+    _choco_arraylist_result (*ops[4])(_choco_bitset, _choco_bitset) = {
+        _choco_bitset_and, _choco_bitset_or, _choco_bitset_xor, _choco_bitset_andnot
+    };
+
+    for (size_t i = 0; i < 4; i++) {
+        _choco_bitset a = init_pattern(1001, 2);
+        ops[i](a, b);
+        counts[i] = _choco_bitset_popcount(a);
+        _choco_bitset_destroy(a);
+    }
+    _choco_bitset_destroy(b);
+}
+
+_gt_test(_choco_bitset_bulk, simd)
+{
+    // act
+    size_t counts[4];
+    run_bulk_ops(counts);
+
+    // assert
+    _gt_test_int_eq(counts[0], 167);
+    _gt_test_int_eq(counts[1], 668);
+    _gt_test_int_eq(counts[2], 501);
+    _gt_test_int_eq(counts[3], 334);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_bulk, scalar)
+{
+    // arrange
+    _choco_cpu_restrict(0);
+
+    // act
+    size_t counts[4];
+    run_bulk_ops(counts);
+
+    // assert
+    _gt_test_int_eq(counts[0], 167);
+    _gt_test_int_eq(counts[1], 668);
+    _gt_test_int_eq(counts[2], 501);
+    _gt_test_int_eq(counts[3], 334);
+    _gt_passed();
+}
+
+_gt_test(_choco_bitset_and, length_mismatch)
+{
+    // arrange
+    _choco_bitset a = init_pattern(100, 2);
+    _choco_bitset b = init_pattern(101, 2);
+
+    // act
+    _choco_arraylist_result result = _choco_bitset_and(a, b);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_bitset_destroy(a);
+    _choco_bitset_destroy(b);
+    _gt_passed();
+}
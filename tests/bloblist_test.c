@@ -0,0 +1,150 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/bloblist.h"
+#include "../src/gt/test.h"
+#include <stdio.h>
+#include <string.h>
+
+// Pushes "key-0" to "key-<count - 1>", each twice, and returns the number of distinct indices.
+static size_t push_keys(_choco_bloblist* list, size_t count)
+{
+    size_t distinct = 0;
+    for (size_t round = 0; round < 2; round++) {
+        for (size_t i = 0; i < count; i++) {
+            char key[32];
+            size_t index;
+            int length = sprintf(key, "key-%zu", i);
+            _choco_bloblist_push(list, key, length, &index);
+            distinct += index == distinct;
+        }
+    }
+    return distinct;
+}
+
+_gt_test(_choco_bloblist_push, )
+{
+    // arrange
+    _choco_bloblist* list = _choco_bloblist_create(_choco_arraylist_heap_allocator(), _CHOCO_BLOBLIST_PLAIN);
+
+    // act
+    size_t first, second;
+    _choco_bloblist_push(list, "hello", 5, &first);
+    _choco_bloblist_push(list, "", 0, NULL);
+    _choco_arraylist_result result = _choco_bloblist_push(list, "hello", 5, &second);
+
+    // assert
+    size_t length;
+    const char* blob = _choco_bloblist_get(list, 2, &length);
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(first, 0);
+    _gt_test_int_eq(second, 2);
+    _gt_test_int_eq(_choco_bloblist_length(list), 3);
+    _gt_test_int_eq(length, 5);
+    _gt_test_int_eq(memcmp(blob, "hello", 5), 0);
+    _choco_bloblist_get(list, 1, &length);
+    _gt_test_int_eq(length, 0);
+    _gt_test_ptr_eq(_choco_bloblist_get(list, 3, &length), NULL);
+    _choco_bloblist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloblist_push, own_blob)
+{
+    // arrange
+    _choco_bloblist* list = _choco_bloblist_create(_choco_arraylist_heap_allocator(), _CHOCO_BLOBLIST_PLAIN);
+    char expected[200];
+    for (size_t i = 0; i < sizeof(expected); i++) {
+        expected[i] = (char)i;
+    }
+    _choco_bloblist_push(list, expected, sizeof(expected), NULL);
+    size_t length;
+    const char* blob = _choco_bloblist_get(list, 0, &length);
+
+    // act
+    _choco_arraylist_result result = _choco_bloblist_push(list, blob, length, NULL);
+
+    // assert
+    blob = _choco_bloblist_get(list, 1, &length);
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(length, sizeof(expected));
+    _gt_test_int_eq(memcmp(blob, expected, sizeof(expected)), 0);
+    _choco_bloblist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloblist_append_n, )
+{
+    // arrange
+    _choco_bloblist* list = _choco_bloblist_create(_choco_arraylist_heap_allocator(), _CHOCO_BLOBLIST_PLAIN);
+    _choco_bloblist_push(list, "a", 1, NULL);
+    size_t lengths[3] = { 3, 0, 5 };
+
+    // act
+    _choco_arraylist_result result = _choco_bloblist_append_n(list, "onethree", lengths, 3);
+
+    // assert
+    size_t length;
+    const char* blob = _choco_bloblist_get(list, 3, &length);
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(_choco_bloblist_length(list), 4);
+    _gt_test_int_eq(length, 5);
+    _gt_test_int_eq(memcmp(blob, "three", 5), 0);
+    blob = _choco_bloblist_get(list, 1, &length);
+    _gt_test_int_eq(memcmp(blob, "one", 3), 0);
+    _choco_bloblist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloblist_push, intern)
+{
+    // arrange
+    _choco_bloblist* list = _choco_bloblist_create(_choco_arraylist_heap_allocator(), _CHOCO_BLOBLIST_INTERN);
+
+    // act
+    size_t distinct = push_keys(list, 1000);
+
+    // assert
+    size_t length;
+    const char* blob = _choco_bloblist_get(list, 999, &length);
+    _gt_test_int_eq(distinct, 1000);
+    _gt_test_int_eq(_choco_bloblist_length(list), 1000);
+    _gt_test_int_eq(length, 7);
+    _gt_test_int_eq(memcmp(blob, "key-999", 7), 0);
+    _choco_bloblist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloblist_find, )
+{
+    // arrange
+    _choco_bloblist* list = _choco_bloblist_create(_choco_arraylist_heap_allocator(), _CHOCO_BLOBLIST_INTERN);
+    push_keys(list, 100);
+
+    // act
+    size_t found = _choco_bloblist_find(list, "key-42", 6);
+    size_t missing = _choco_bloblist_find(list, "key-420", 7);
+
+    // assert
+    _gt_test_int_eq(found, 42);
+    _gt_test_int_eq(missing, 100);
+    _choco_bloblist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloblist_find, plain)
+{
+    // arrange
+    _choco_bloblist* list = _choco_bloblist_create(_choco_arraylist_heap_allocator(), _CHOCO_BLOBLIST_PLAIN);
+    size_t distinct = push_keys(list, 10);
+
+    // act
+    size_t found = _choco_bloblist_find(list, "key-1", 5);
+
+    // assert
+    _gt_test_int_eq(distinct, 20);
+    _gt_test_int_eq(found, 20);
+    _choco_bloblist_destroy(list);
+    _gt_passed();
+}
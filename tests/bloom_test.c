@@ -0,0 +1,135 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/bloom.h"
+#include "../src/cpu.h"
+#include "../src/gt/test.h"
+
+// Adds the keys first to first + count - 1, one at a time.
+static _choco_bloom* init_filter(uint64_t first, size_t count)
+{
+    _choco_bloom* filter = _choco_bloom_create(_choco_arraylist_heap_allocator(), count, 10);
+    for (uint64_t key = first; key < first + count; key++) {
+        _choco_bloom_add(filter, key);
+    }
+    return filter;
+}
+
+// Number of keys from first to first + count - 1 reported as present.
+static size_t count_present(const _choco_bloom* filter, uint64_t first, size_t count)
+{
+    size_t present = 0;
+    for (uint64_t key = first; key < first + count; key++) {
+        present += _choco_bloom_contains(filter, key) == _CHOCO_ARRAYLIST_RESULT_YES;
+    }
+    return present;
+}
+
+_gt_test(_choco_bloom_add, )
+{
+    // arrange
+    size_t count = 10000;
+
+    // act
+    _choco_bloom* filter = init_filter(0, count);
+
+    // assert
+    size_t false_positives = count_present(filter, count, 100000);
+    _gt_test_int_eq(filter->count, 196);
+    _gt_test_int_eq((uintptr_t)filter->blocks % _CHOCO_BLOOM_BLOCK, 0);
+    _gt_test_int_eq(count_present(filter, 0, count), count);
+    _gt_test_int_lt(false_positives, 2000);
+    _choco_bloom_destroy(filter);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloom_add, scalar)
+{
+    // arrange
+    _choco_bloom* expected = init_filter(0, 1000);
+    _choco_cpu_restrict(0);
+
+    // act
+    _choco_bloom* filter = init_filter(0, 1000);
+
+    // assert
+    _gt_test_int_eq(memcmp(filter->blocks, expected->blocks, filter->count * _CHOCO_BLOOM_BLOCK), 0);
+    _gt_test_int_eq(count_present(filter, 0, 1000), 1000);
+    _gt_test_int_eq(count_present(filter, 1000, 10000), count_present(expected, 1000, 10000));
+    _choco_bloom_destroy(expected);
+    _choco_bloom_destroy(filter);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloom_add_n, )
+{
+    // arrange
+    uint64_t keys[100];
+    uint8_t found[100];
+    for (size_t i = 0; i < 100; i++) {
+        keys[i] = i * 0x9E3779B97F4A7C15;
+    }
+    _choco_bloom* filter = _choco_bloom_create(_choco_arraylist_heap_allocator(), 100, 16);
+
+    // act
+    _choco_arraylist_result result = _choco_bloom_add_n(filter, keys, 50);
+    size_t present = _choco_bloom_contains_n(filter, keys, 100, found);
+
+    // assert
+    size_t first_half = 0;
+    for (size_t i = 0; i < 50; i++) {
+        first_half += found[i];
+    }
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(first_half, 50);
+    _gt_test_int_lt(present, 55);
+    _choco_bloom_destroy(filter);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloom_union, )
+{
+    // arrange
+    _choco_bloom* dst = init_filter(0, 1000);
+    _choco_bloom* src = init_filter(5000, 1000);
+    _choco_bloom* other = _choco_bloom_create(_choco_arraylist_heap_allocator(), 100000, 10);
+
+    // act
+    _choco_arraylist_result result = _choco_bloom_union(dst, src);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(count_present(dst, 0, 1000), 1000);
+    _gt_test_int_eq(count_present(dst, 5000, 1000), 1000);
+    _gt_test_int_eq(_choco_bloom_union(dst, other), _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_bloom_destroy(dst);
+    _choco_bloom_destroy(src);
+    _choco_bloom_destroy(other);
+    _gt_passed();
+}
+
+_gt_test(_choco_bloom_serialize, )
+{
+    // arrange
+    _choco_bloom* filter = init_filter(0, 500);
+    size_t required = _choco_bloom_serialize(filter, NULL, 0);
+    void* buffer = malloc(required);
+
+    // act
+    size_t written = _choco_bloom_serialize(filter, buffer, required);
+    _choco_bloom* copy = _choco_bloom_deserialize(_choco_arraylist_heap_allocator(), buffer, written);
+    _choco_arraylist blocks = _choco_arraylist_deserialize(_choco_arraylist_heap_allocator(), buffer, written);
+
+    // assert
+    _gt_test_int_eq(written, sizeof(_choco_arraylist_image) + filter->count * _CHOCO_BLOOM_BLOCK);
+    _gt_test_int_eq(count_present(copy, 0, 500), 500);
+    _gt_test_int_eq(_choco_arraylist_length(blocks), filter->count);
+    _gt_test_int_eq(memcmp(blocks, filter->blocks, filter->count * _CHOCO_BLOOM_BLOCK), 0);
+    _gt_test_ptr_eq(_choco_bloom_deserialize(_choco_arraylist_heap_allocator(), buffer, written - 1), NULL);
+    _choco_bloom_destroy(filter);
+    _choco_bloom_destroy(copy);
+    _choco_arraylist_destroy(blocks);
+    free(buffer);
+    _gt_passed();
+}
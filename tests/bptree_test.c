@@ -0,0 +1,193 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/bptree.h"
+#include "../src/cpu.h"
+#include "../src/gt/test.h"
+#include <stddef.h>
+
+typedef struct record {
+    uint32_t payload;
+    uint64_t key;
+} record;
+
+// Inserts the keys 0 to count - 1 in a scrambled order, each with its square as value.
+static _choco_bptree* init_tree(size_t count)
+{
+    _choco_bptree* tree = _choco_bptree_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t));
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = (i * 7919) % count;
+        uint64_t value = key * key;
+        _choco_bptree_insert(tree, key, &value);
+    }
+    return tree;
+}
+
+// Number of keys from 0 to count - 1 whose value is their square.
+static size_t count_found(const _choco_bptree* tree, size_t count)
+{
+    size_t found = 0;
+    for (uint64_t key = 0; key < count; key++) {
+        uint64_t* value = _choco_bptree_find(tree, key);
+        found += value != NULL && *value == key * key;
+    }
+    return found;
+}
+
+// Number of entries from the first key not below `low`, up to `high` excluded, checking that
+// keys increase.
+static size_t count_range(const _choco_bptree* tree, uint64_t low, uint64_t high)
+{
+    size_t count = 0;
+    uint64_t previous = 0;
+    _choco_bptree_cursor cursor = _choco_bptree_lower_bound(tree, low);
+    while (_choco_bptree_cursor_valid(&cursor) == _CHOCO_ARRAYLIST_RESULT_YES) {
+        uint64_t key = _choco_bptree_cursor_key(&cursor);
+        if (key >= high || (count > 0 && key <= previous)) {
+            break;
+        }
+
+        previous = key;
+        count++;
+        _choco_bptree_cursor_next(&cursor);
+    }
+    return count;
+}
+
+_gt_test(_choco_bptree_insert, )
+{
+    // arrange
+    size_t count = 10000;
+
+    // act
+    _choco_bptree* tree = init_tree(count);
+
+    // assert
+    _gt_test_int_eq(_choco_bptree_length(tree), count);
+    _gt_test_int_eq(count_found(tree, count), count);
+    _gt_test_int_gt(tree->height, 2);
+    _gt_test_ptr_eq(_choco_bptree_find(tree, count), NULL);
+    _choco_bptree_destroy(tree);
+    _gt_passed();
+}
+
+_gt_test(_choco_bptree_insert, replaces_value)
+{
+    // arrange
+    _choco_bptree* tree = init_tree(100);
+    uint64_t value = 1;
+
+    // act
+    _choco_arraylist_result result = _choco_bptree_insert(tree, 50, &value);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(_choco_bptree_length(tree), 100);
+    _gt_test_int_eq(*(uint64_t*)_choco_bptree_find(tree, 50), 1);
+    _choco_bptree_destroy(tree);
+    _gt_passed();
+}
+
+_gt_test(_choco_bptree_insert, scalar)
+{
+    // arrange
+    _choco_cpu_restrict(0);
+
+    // act
+    _choco_bptree* tree = init_tree(5000);
+
+    // assert
+    _gt_test_int_eq(count_found(tree, 5000), 5000);
+    _gt_test_int_eq(count_range(tree, 0, UINT64_MAX), 5000);
+    _choco_bptree_destroy(tree);
+    _gt_passed();
+}
+
+_gt_test(_choco_bptree_lower_bound, )
+{
+    // arrange
+    _choco_bptree* tree = init_tree(1000);
+
+    // act
+    _choco_bptree_cursor cursor = _choco_bptree_lower_bound(tree, 500);
+    _choco_bptree_cursor end = _choco_bptree_lower_bound(tree, 1000);
+
+    // assert
+    _gt_test_int_eq(_choco_bptree_cursor_key(&cursor), 500);
+    _gt_test_int_eq(*(uint64_t*)_choco_bptree_cursor_value(&cursor), 250000);
+    _gt_test_int_eq(count_range(tree, 100, 300), 200);
+    _gt_test_int_eq(count_range(tree, 0, UINT64_MAX), 1000);
+    _gt_test_int_eq(_choco_bptree_cursor_valid(&end), _CHOCO_ARRAYLIST_RESULT_NO);
+    _gt_test_int_eq(_choco_bptree_cursor_next(&end), _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_bptree_destroy(tree);
+    _gt_passed();
+}
+
+_gt_test(_choco_bptree_erase, )
+{
+    // arrange
+    _choco_bptree* tree = init_tree(1000);
+
+    // act
+    for (uint64_t key = 100; key < 400; key++) {
+        _choco_bptree_erase(tree, key);
+    }
+    _choco_arraylist_result missing = _choco_bptree_erase(tree, 200);
+
+    // assert
+    _choco_bptree_cursor cursor = _choco_bptree_lower_bound(tree, 100);
+    _gt_test_int_eq(missing, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _gt_test_int_eq(_choco_bptree_length(tree), 700);
+    _gt_test_ptr_eq(_choco_bptree_find(tree, 250), NULL);
+    _gt_test_int_eq(*(uint64_t*)_choco_bptree_find(tree, 400), 160000);
+    _gt_test_int_eq(_choco_bptree_cursor_key(&cursor), 400);
+    _gt_test_int_eq(count_range(tree, 0, UINT64_MAX), 700);
+    _choco_bptree_destroy(tree);
+    _gt_passed();
+}
+
+_gt_test(_choco_bptree_build, )
+{
+    // arrange
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(record), 16);
+    arrlist = _choco_arraylist_add_n(arrlist, 5000);
+    for (size_t i = 0; i < 5000; i++) {
+        ((record*)arrlist)[i] = (record) { .payload = (uint32_t)i, .key = 10 * i };
+    }
+
+    // act
+    _choco_bptree* tree = _choco_bptree_build(_choco_arraylist_heap_allocator(), arrlist, offsetof(record, key));
+    record extra = { .payload = 7, .key = 15 };
+    _choco_bptree_insert(tree, extra.key, &extra);
+
+    // assert
+    _gt_test_ptr_neq(tree, NULL);
+    _gt_test_int_eq(_choco_bptree_length(tree), 5001);
+    _gt_test_int_eq(tree->height, 3);
+    _gt_test_int_eq(((record*)_choco_bptree_find(tree, 49990))->payload, 4999);
+    _gt_test_int_eq(((record*)_choco_bptree_find(tree, 15))->payload, 7);
+    _gt_test_ptr_eq(_choco_bptree_find(tree, 25), NULL);
+    _gt_test_int_eq(count_range(tree, 0, UINT64_MAX), 5001);
+    _choco_bptree_destroy(tree);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_bptree_build, unsorted)
+{
+    // arrange
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), 4);
+    arrlist = _choco_arraylist_add_n(arrlist, 3);
+    ((uint64_t*)arrlist)[0] = 1;
+    ((uint64_t*)arrlist)[1] = 3;
+    ((uint64_t*)arrlist)[2] = 3;
+
+    // act
+    _choco_bptree* tree = _choco_bptree_build(_choco_arraylist_heap_allocator(), arrlist, 0);
+
+    // assert
+    _gt_test_ptr_eq(tree, NULL);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
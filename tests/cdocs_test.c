@@ -0,0 +1,87 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/cdocs/cdocs.h"
+#include "../src/gt/test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char* expected_add =
+    "---\n## `add`\n### Description\nAdds two numbers\n### Returns: `int`\nThe sum\n### Parameters\n"
+    "`int a` : First operand\n`int b` : Second operand\n\n";
+
+// Reads the whole file into `content`, which holds `capacity` bytes; returns the length read.
+static size_t read_file(const char* filename, char* content, size_t capacity)
+{
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        return 0;
+    }
+
+    size_t length = fread(content, 1, capacity - 1, file);
+    content[length] = '\0';
+    fclose(file);
+    return length;
+}
+
+_gt_test(_cdocs_generate_documentation_x, )
+{
+    // arrange
+    char filename[] = "/tmp/cdocs_test_XXXXXX";
+    close(mkstemp(filename));
+    _cdocs_fn_struct functions[] = {
+        _cdocs_fn(_cdocs_fn_f(add, "Adds two numbers"), _cdocs_fn_r(int, "The sum"),
+            _cdocs_fn_p(int a, "First operand"), _cdocs_fn_p(int b, "Second operand")),
+        _cdocs_fn(_cdocs_fn_f(now, "Current time"), _cdocs_fn_r(long, "Seconds")),
+    };
+
+    // act
+    int first = _cdocs_generate_documentation_x(filename, "Math", 2, functions);
+    int second = _cdocs_generate_documentation_x(filename, "Math", 2, functions);
+
+    // assert
+    char content[1024];
+    char expected[1024];
+    snprintf(expected, sizeof(expected), "<!-- Generated by cdocs. -->\n# Math\n\n%s%s", expected_add,
+        "---\n## `now`\n### Description\nCurrent time\n### Returns: `long`\nSeconds\n### Parameters\n\n");
+    read_file(filename, content, sizeof(content));
+    _gt_test_int_eq(functions[0].parameter_count, 2);
+    _gt_test_int_eq(functions[1].parameter_count, 0);
+    _gt_test_int_eq(first, 1);
+    _gt_test_int_eq(second, 0);
+    _gt_test_int_eq(strcmp(content, expected), 0);
+    unlink(filename);
+    _gt_passed();
+}
+
+_gt_test(_cdocs_generate_documentation_n, )
+{
+    // arrange
+    char filename[] = "/tmp/cdocs_test_XXXXXX";
+    close(mkstemp(filename));
+    _cdocs_fn_struct math[] = {
+        _cdocs_fn(_cdocs_fn_f(add, "Adds two numbers"), _cdocs_fn_r(int, "The sum"),
+            _cdocs_fn_p(int a, "First operand"), _cdocs_fn_p(int b, "Second operand")),
+    };
+    _cdocs_subject_struct subjects[] = {
+        _cdocs_subject("Math", math),
+        _cdocs_subject("More math", math),
+    };
+    _cdocs_generate_documentation_n(filename, subjects, 1);
+
+    // act
+    int written = _cdocs_generate_documentation_n(filename, subjects, 2);
+
+    // assert
+    char content[1024];
+    char expected[1024];
+    snprintf(expected, sizeof(expected), "<!-- Generated by cdocs. -->\n# Math\n\n%s# More math\n\n%s", expected_add, expected_add);
+    read_file(filename, content, sizeof(content));
+    _gt_test_int_eq(written, 1);
+    _gt_test_int_eq(strcmp(content, expected), 0);
+    unlink(filename);
+    _gt_passed();
+}
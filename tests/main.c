@@ -2,10 +2,10 @@
     Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
 */
 
-#include "arraylist_test.h"
+#include "../src/gt/test.h"
 
+// Tests register themselves through `_gt_test`; see `_gt_main` for the runner options.
 int main(int argc, char** argv)
 {
-    _choco_arraylist_test();
-    return 0;
-}
\ No newline at end of file
+    return _gt_main(argc, argv);
+}
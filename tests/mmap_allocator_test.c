@@ -0,0 +1,111 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/mmap_allocator.h"
+#include "../src/gt/test.h"
+#include <stdint.h>
+#include <unistd.h>
+
+static _choco_arraylist fill(_choco_arraylist arrlist, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        arrlist = _choco_arraylist_add(arrlist);
+        *(size_t*)_choco_arraylist_at(arrlist, i) = i;
+    }
+    return arrlist;
+}
+
+static int is_filled(_choco_arraylist arrlist, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (*(size_t*)_choco_arraylist_at(arrlist, i) != i) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+_gt_test(_choco_arraylist_mmap_allocator, below_threshold)
+{
+    // arrange
+    _choco_arraylist_mmap_options options = _choco_arraylist_mmap_defaults();
+    _choco_arraylist_allocator allocator = _choco_arraylist_mmap_allocator(&options);
+
+    // act
+    _choco_arraylist arrlist = _choco_arraylist_create(allocator, sizeof(size_t), 16);
+    arrlist = fill(arrlist, 100);
+
+    // assert
+    _gt_test_ptr_neq(arrlist, NULL);
+    _gt_test_int_eq(is_filled(arrlist, 100), 1);
+    _choco_arraylist_result destroyed = _choco_arraylist_destroy(arrlist);
+    _gt_test_int_eq(destroyed, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_mmap_allocator, mapped_growth)
+{
+    // arrange
+    _choco_arraylist_mmap_options options = _choco_arraylist_mmap_defaults();
+    options.threshold = 0;
+    options.huge_pages = 0;
+    _choco_arraylist_allocator allocator = _choco_arraylist_mmap_allocator(&options);
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    // act
+    _choco_arraylist arrlist = _choco_arraylist_create(allocator, sizeof(size_t), 1);
+    arrlist = fill(arrlist, 200000);
+
+    // assert
+    _choco_arraylist_header* header = _choco_arraylist_get_header(arrlist);
+    _gt_test_int_eq((uintptr_t)header % page, 16);
+    _gt_test_int_eq(is_filled(arrlist, 200000), 1);
+    _choco_arraylist_result destroyed = _choco_arraylist_destroy(arrlist);
+    _gt_test_int_eq(destroyed, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_mmap_allocator, shrink)
+{
+    // arrange
+    _choco_arraylist_mmap_options options = _choco_arraylist_mmap_defaults();
+    options.threshold = 0;
+    options.huge_pages = 0;
+    _choco_arraylist_allocator allocator = _choco_arraylist_mmap_allocator(&options);
+    _choco_arraylist arrlist = _choco_arraylist_create(allocator, sizeof(size_t), 100000);
+    arrlist = fill(arrlist, 100000);
+
+    // act
+    _choco_arraylist result = _choco_arraylist_resize(arrlist, 1000);
+
+    // assert
+    _gt_test_ptr_eq(result, arrlist);
+    _gt_test_int_eq(_choco_arraylist_length(result), 1000);
+    _gt_test_int_eq(is_filled(result, 1000), 1);
+    _choco_arraylist_result destroyed = _choco_arraylist_destroy(result);
+    _gt_test_int_eq(destroyed, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_mmap_allocator, huge_pages)
+{
+    // arrange
+    _choco_arraylist_mmap_options options = _choco_arraylist_mmap_defaults();
+    options.populate = 1;
+    options.numa_node = 0;
+    _choco_arraylist_allocator allocator = _choco_arraylist_mmap_allocator(&options);
+
+    // act
+    _choco_arraylist arrlist = _choco_arraylist_create(allocator, sizeof(size_t), 300000);
+    arrlist = fill(arrlist, 600000);
+    arrlist = _choco_arraylist_resize(arrlist, 300000);
+
+    // assert
+    _gt_test_ptr_neq(arrlist, NULL);
+    _gt_test_int_eq(_choco_arraylist_length(arrlist), 300000);
+    _gt_test_int_eq(is_filled(arrlist, 300000), 1);
+    _choco_arraylist_result destroyed = _choco_arraylist_destroy(arrlist);
+    _gt_test_int_eq(destroyed, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_passed();
+}
@@ -0,0 +1,259 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/cpu.h"
+#include "../src/gt/test.h"
+#include "../src/numeric.h"
+#include "../src/pool_allocator.h"
+
+// 1003 elements, so that every kernel also runs its scalar tail.
+#define SAMPLES (1003)
+
+static _choco_arraylist init_i32(void)
+{
+    _choco_arraylist list = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(int32_t), SAMPLES);
+    list = _choco_arraylist_add_n(list, SAMPLES);
+    for (int32_t i = 0; i < SAMPLES; i++) {
+        ((int32_t*)list)[i] = (i * 7919) % 1000 - 500;
+    }
+    return list;
+}
+
+static _choco_arraylist init_f64(void)
+{
+    _choco_arraylist list = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(double), SAMPLES);
+    list = _choco_arraylist_add_n(list, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        ((double*)list)[i] = (i * 7919) % 1000 / 4.0;
+    }
+    return list;
+}
+
+// Number of elements of the inclusive and exclusive scans of 0, 1, 2... that are wrong.
+static size_t count_scan_mismatches(void)
+{
+    _choco_arraylist inclusive = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), SAMPLES);
+    inclusive = _choco_arraylist_add_n(inclusive, SAMPLES);
+    for (uint64_t i = 0; i < SAMPLES; i++) {
+        ((uint64_t*)inclusive)[i] = i;
+    }
+
+    _choco_arraylist exclusive = _choco_arraylist_unshare(_choco_arraylist_snapshot(inclusive));
+    _choco_numeric_inclusive_scan_u64(inclusive);
+    _choco_numeric_exclusive_scan_u64(exclusive);
+
+    size_t mismatches = 0;
+    for (uint64_t i = 0; i < SAMPLES; i++) {
+        mismatches += ((uint64_t*)inclusive)[i] != i * (i + 1) / 2;
+        mismatches += ((uint64_t*)exclusive)[i] != i * (i - 1) / 2;
+    }
+
+    _choco_arraylist_destroy(inclusive);
+    _choco_arraylist_destroy(exclusive);
+    return mismatches;
+}
+
+_gt_test(_choco_numeric_sum, i32)
+{
+    // arrange
+    _choco_arraylist list = init_i32();
+    int64_t expected = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        expected += ((int32_t*)list)[i];
+    }
+
+    // act
+    int64_t sum;
+    _choco_arraylist_result result = _choco_numeric_sum_i32(list, &sum);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(sum, expected);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_sum, scalar)
+{
+    // arrange
+    _choco_cpu_restrict(0);
+    _choco_arraylist list = init_f64();
+    double expected = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        expected += ((double*)list)[i];
+    }
+
+    // act
+    double sum;
+    _choco_numeric_sum_f64(list, &sum);
+
+    // assert
+    _gt_test_float_eq(sum, expected);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_sum, size_mismatch)
+{
+    // arrange
+    _choco_arraylist list = init_i32();
+
+    // act
+    int64_t sum;
+    _choco_arraylist_result result = _choco_numeric_sum_i64(list, &sum);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_minmax, f64)
+{
+    // arrange
+    _choco_arraylist list = init_f64();
+    ((double*)list)[SAMPLES - 1] = -3.5;
+
+    // act
+    double min, max;
+    _choco_arraylist_result result = _choco_numeric_minmax_f64(list, &min, &max);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_float_eq(min, -3.5);
+    _gt_test_float_eq(max, 249.75);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_min, empty)
+{
+    // arrange
+    _choco_arraylist list = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(int32_t), 4);
+
+    // act
+    int32_t min;
+    _choco_arraylist_result result = _choco_numeric_min_i32(list, &min);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_scan, simd)
+{
+    // act
+    size_t mismatches = count_scan_mismatches();
+
+    // assert
+    _gt_test_int_eq(mismatches, 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_scan, scalar)
+{
+    // arrange
+    _choco_cpu_restrict(0);
+
+    // act
+    size_t mismatches = count_scan_mismatches();
+
+    // assert
+    _gt_test_int_eq(mismatches, 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_scan, shared)
+{
+    // arrange
+    _choco_arraylist list = init_i32();
+    _choco_arraylist snapshot = _choco_arraylist_snapshot(list);
+
+    // act
+    _choco_arraylist_result result = _choco_numeric_inclusive_scan_i32(list);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_arraylist_release(snapshot);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_transform, clamp)
+{
+    // arrange
+    _choco_arraylist list = init_i32();
+
+    // act
+    _choco_arraylist_result result = _choco_numeric_transform_i32(list, _CHOCO_NUMERIC_CLAMP, -100, 100);
+
+    // assert
+    int32_t min, max;
+    _choco_numeric_minmax_i32(list, &min, &max);
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(min, -100);
+    _gt_test_int_eq(max, 100);
+    _gt_test_int_eq(((int32_t*)list)[0], -100);
+    _gt_test_int_eq(((int32_t*)list)[5], (5 * 7919 % 1000) - 500);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_transform, scale_add)
+{
+    // arrange
+    _choco_arraylist list = init_f64();
+
+    // act
+    _choco_numeric_transform_f64(list, _CHOCO_NUMERIC_SCALE, 4.0, 0.0);
+    _choco_numeric_transform_f64(list, _CHOCO_NUMERIC_ADD, 1.0, 0.0);
+
+    // assert
+    _gt_test_float_eq(((double*)list)[0], 1.0);
+    _gt_test_float_eq(((double*)list)[SAMPLES - 1], (SAMPLES - 1) * 7919 % 1000 + 1.0);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_histogram, )
+{
+    // arrange
+    _choco_arraylist list = init_i32();
+    size_t bins[4];
+
+    // act
+    _choco_arraylist_result result = _choco_numeric_histogram_i32(list, -400, 400, bins, 4);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(bins[0] + bins[1] + bins[2] + bins[3], 801);
+    _gt_test_int_eq(bins[0], 200);
+    _gt_test_int_eq(bins[3], 201);
+    _choco_arraylist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_numeric_histogram, pooled)
+{
+    // arrange
+    _choco_arraylist_pool pool;
+    _choco_arraylist_pool_init(&pool, _choco_arraylist_heap_allocator(), sizeof(_choco_arraylist_header) + SAMPLES * sizeof(int32_t), 1);
+    _choco_arraylist list = _choco_arraylist_create(_choco_arraylist_pool_allocator(&pool), sizeof(int32_t), SAMPLES);
+    list = _choco_arraylist_add_n(list, SAMPLES);
+    for (int32_t i = 0; i < SAMPLES; i++) {
+        ((int32_t*)list)[i] = i;
+    }
+    size_t bins[1000];
+
+    // act
+    _choco_arraylist_result result = _choco_numeric_histogram_i32(list, 0, 1000, bins, 1000);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(bins[0], 1);
+    _gt_test_int_eq(bins[999], 1);
+    _choco_arraylist_pool_release(&pool);
+    _gt_passed();
+}
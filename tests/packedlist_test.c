@@ -0,0 +1,173 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/cpu.h"
+#include "../src/gt/test.h"
+#include "../src/packedlist.h"
+
+// Sorted ids with gaps of 1 to 200, the shape of a posting list.
+static uint64_t init_id(size_t index)
+{
+    return 1000000 + index * 100 + (index * 7919) % 100;
+}
+
+static _choco_packedlist* init_ids(size_t count)
+{
+    _choco_packedlist* list = _choco_packedlist_create(_choco_arraylist_heap_allocator(), _CHOCO_PACKEDLIST_DELTA);
+    for (size_t i = 0; i < count; i++) {
+        _choco_packedlist_push(list, init_id(i));
+    }
+    return list;
+}
+
+// Number of values of a full decode of `count` ids that differ from the pushed ones.
+static size_t count_decode_mismatches(size_t count)
+{
+    _choco_packedlist* list = init_ids(count);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), 0);
+    dst = _choco_packedlist_decode(list, 0, count, dst);
+
+    size_t mismatches = count - _choco_arraylist_length(dst);
+    for (size_t i = 0; i < _choco_arraylist_length(dst); i++) {
+        mismatches += ((uint64_t*)dst)[i] != init_id(i);
+    }
+
+    _choco_arraylist_destroy(dst);
+    _choco_packedlist_destroy(list);
+    return mismatches;
+}
+
+_gt_test(_choco_packedlist_get, delta)
+{
+    // arrange
+    _choco_packedlist* list = init_ids(1000);
+
+    // act
+    uint64_t first, packed, tail;
+    _choco_arraylist_result result = _choco_packedlist_get(list, 0, &first);
+    _choco_packedlist_get(list, 777, &packed);
+    _choco_packedlist_get(list, 999, &tail);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(_choco_packedlist_length(list), 1000);
+    _gt_test_int_eq(first, init_id(0));
+    _gt_test_int_eq(packed, init_id(777));
+    _gt_test_int_eq(tail, init_id(999));
+    _gt_test_int_eq(_choco_packedlist_get(list, 1000, &tail), _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _choco_packedlist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_packedlist_push, delta_rejects_decreasing)
+{
+    // arrange
+    _choco_packedlist* list = init_ids(128);
+
+    // act
+    _choco_arraylist_result result = _choco_packedlist_push(list, init_id(127) - 1);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _gt_test_int_eq(_choco_packedlist_length(list), 128);
+    _choco_packedlist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_packedlist_push, frame)
+{
+    // arrange
+    _choco_packedlist* list = _choco_packedlist_create(_choco_arraylist_heap_allocator(), _CHOCO_PACKEDLIST_FRAME);
+    uint64_t values[300];
+    for (size_t i = 0; i < 300; i++) {
+        values[i] = i % 3 == 0 ? UINT64_MAX - i : i * 31 % 17;
+    }
+
+    // act
+    _choco_arraylist_result result = _choco_packedlist_push_n(list, values, 300);
+
+    // assert
+    uint64_t value;
+    _choco_packedlist_get(list, 129, &value);
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(value, UINT64_MAX - 129);
+    _choco_packedlist_get(list, 130, &value);
+    _gt_test_int_eq(value, 130 * 31 % 17);
+    _choco_packedlist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_packedlist_decode, range)
+{
+    // arrange
+    _choco_packedlist* list = init_ids(500);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), 0);
+    dst = _choco_arraylist_add(dst);
+
+    // act
+    dst = _choco_packedlist_decode(list, 100, 350, dst);
+
+    // assert
+    _gt_test_int_eq(_choco_arraylist_length(dst), 351);
+    _gt_test_int_eq(((uint64_t*)dst)[0], 0);
+    _gt_test_int_eq(((uint64_t*)dst)[1], init_id(100));
+    _gt_test_int_eq(((uint64_t*)dst)[156], init_id(255));
+    _gt_test_int_eq(((uint64_t*)dst)[350], init_id(449));
+    _choco_arraylist_destroy(dst);
+    _choco_packedlist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_packedlist_decode, out_of_range)
+{
+    // arrange
+    _choco_packedlist* list = init_ids(10);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), 0);
+
+    // act
+    dst = _choco_packedlist_decode(list, 5, 6, dst);
+
+    // assert
+    _gt_test_int_eq(_choco_arraylist_length(dst), 0);
+    _choco_arraylist_destroy(dst);
+    _choco_packedlist_destroy(list);
+    _gt_passed();
+}
+
+_gt_test(_choco_packedlist_decode, simd)
+{
+    // act
+    size_t mismatches = count_decode_mismatches(10000);
+
+    // assert
+    _gt_test_int_eq(mismatches, 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_packedlist_decode, scalar)
+{
+    // arrange
+    _choco_cpu_restrict(0);
+
+    // act
+    size_t mismatches = count_decode_mismatches(10000);
+
+    // assert
+    _gt_test_int_eq(mismatches, 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_packedlist_sizeof, compression)
+{
+    // arrange
+    size_t count = 100000;
+
+    // act
+    _choco_packedlist* list = init_ids(count);
+
+    // assert
+    _gt_test_int_lt(_choco_packedlist_sizeof(list) * 4, count * sizeof(uint64_t));
+    _choco_packedlist_destroy(list);
+    _gt_passed();
+}
@@ -0,0 +1,170 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/gt/test.h"
+#include "../src/partition.h"
+#include "../src/pool_allocator.h"
+#include <stdint.h>
+
+// Elements of `size` bytes whose first 4 bytes hold their index and whose key, at
+// `key_offset`, is a scrambled 2 byte value.
+static _choco_arraylist init_records(size_t size, size_t key_offset, size_t count)
+{
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), size, count);
+    arrlist = _choco_arraylist_add_n(arrlist, count);
+    for (size_t i = 0; i < count; i++) {
+        char* record = _choco_arraylist_at(arrlist, i);
+        uint32_t index = (uint32_t)i;
+        uint16_t key = (uint16_t)(i * 7919);
+        memcpy(record, &index, sizeof(index));
+        memcpy(record + key_offset, &key, sizeof(key));
+    }
+    return arrlist;
+}
+
+// Checks that every element from `first` sits in the partition of its key, in input order.
+static int is_partitioned(_choco_arraylist out, size_t first, size_t key_offset, unsigned bits, const size_t* offsets)
+{
+    size_t partitions = (size_t)1 << bits;
+    if (offsets[0] != first || offsets[partitions] != _choco_arraylist_length(out)) {
+        return 0;
+    }
+
+    for (size_t p = 0; p < partitions; p++) {
+        for (size_t i = offsets[p]; i < offsets[p + 1]; i++) {
+            const char* record = _choco_arraylist_at(out, i);
+            uint32_t index, previous;
+            uint16_t key;
+            memcpy(&index, record, sizeof(index));
+            memcpy(&key, record + key_offset, sizeof(key));
+            if ((key & (partitions - 1)) != p) {
+                return 0;
+            }
+
+            if (i > offsets[p]) {
+                memcpy(&previous, _choco_arraylist_at(out, i - 1), sizeof(previous));
+                if (previous >= index) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+_gt_test(_choco_partition, )
+{
+    // arrange
+    size_t offsets[17];
+    _choco_arraylist arrlist = init_records(8, 4, 10000);
+    _choco_arraylist out = _choco_arraylist_create(_choco_arraylist_heap_allocator(), 8, 4);
+
+    // act
+    out = _choco_partition(arrlist, 4, 2, 4, out, offsets);
+
+    // assert
+    _gt_test_int_eq(_choco_arraylist_length(out), 10000);
+    _gt_test_int_eq(is_partitioned(out, 0, 4, 4, offsets), 1);
+    _choco_arraylist_destroy(arrlist);
+    _choco_arraylist_destroy(out);
+    _gt_passed();
+}
+
+_gt_test(_choco_partition, element_sizes)
+{
+    // arrange
+    size_t sizes[4] = { 6, 16, 24, 80 };
+    size_t offsets[257];
+
+    for (int s = 0; s < 4; s++) {
+        _choco_arraylist arrlist = init_records(sizes[s], 4, 5000);
+        _choco_arraylist out = init_records(sizes[s], 4, 3);
+
+        // act
+        out = _choco_partition(arrlist, 4, 2, 8, out, offsets);
+
+        // assert
+        _gt_test_int_eq(_choco_arraylist_length(out), 5003);
+        _gt_test_int_eq(is_partitioned(out, 3, 4, 8, offsets), 1);
+        _choco_arraylist_destroy(arrlist);
+        _choco_arraylist_destroy(out);
+    }
+    _gt_passed();
+}
+
+_gt_test(_choco_partition_parallel, )
+{
+    // arrange
+    size_t expected_offsets[1025];
+    size_t offsets[1025];
+    _choco_arraylist arrlist = init_records(16, 8, 100000);
+    _choco_arraylist expected = _choco_arraylist_create(_choco_arraylist_heap_allocator(), 16, 4);
+    _choco_arraylist out = _choco_arraylist_create(_choco_arraylist_heap_allocator(), 16, 4);
+    expected = _choco_partition(arrlist, 8, 2, 10, expected, expected_offsets);
+
+    // act
+    out = _choco_partition_parallel(arrlist, 8, 2, 10, out, offsets, 4);
+
+    // assert
+    _gt_test_int_eq(is_partitioned(out, 0, 8, 10, offsets), 1);
+    _gt_test_int_eq(memcmp(offsets, expected_offsets, sizeof(offsets)), 0);
+    _gt_test_int_eq(memcmp(out, expected, 100000 * 16), 0);
+    _choco_arraylist_destroy(arrlist);
+    _choco_arraylist_destroy(expected);
+    _choco_arraylist_destroy(out);
+    _gt_passed();
+}
+
+_gt_test(_choco_partition, pooled)
+{
+    // arrange
+    size_t offsets[65537];
+    _choco_arraylist_pool pool;
+    _choco_arraylist_pool_init(&pool, _choco_arraylist_heap_allocator(), 128 * 1024, 2);
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_pool_allocator(&pool), 8, 10000);
+    arrlist = _choco_arraylist_add_n(arrlist, 10000);
+    for (size_t i = 0; i < 10000; i++) {
+        uint32_t index = (uint32_t)i;
+        uint16_t key = (uint16_t)(i * 7919);
+        memcpy(_choco_arraylist_at(arrlist, i), &index, sizeof(index));
+        memcpy((char*)_choco_arraylist_at(arrlist, i) + 4, &key, sizeof(key));
+    }
+    _choco_arraylist out = _choco_arraylist_create(_choco_arraylist_heap_allocator(), 8, 4);
+
+    // act
+    out = _choco_partition(arrlist, 4, 2, 16, out, offsets);
+
+    // assert
+    _gt_test_int_eq(_choco_arraylist_length(out), 10000);
+    _gt_test_int_eq(is_partitioned(out, 0, 4, 16, offsets), 1);
+    _choco_arraylist_destroy(out);
+    _choco_arraylist_pool_release(&pool);
+    _gt_passed();
+}
+
+_gt_test(_choco_partition, invalid)
+{
+    // arrange
+    size_t offsets[3];
+    _choco_arraylist arrlist = init_records(8, 4, 10);
+    _choco_arraylist out = _choco_arraylist_create(_choco_arraylist_heap_allocator(), 8, 4);
+    _choco_arraylist narrow = _choco_arraylist_create(_choco_arraylist_heap_allocator(), 4, 4);
+
+    // act
+    out = _choco_partition(arrlist, 4, 3, 1, out, offsets);
+    out = _choco_partition(arrlist, 6, 4, 1, out, offsets);
+    out = _choco_partition(arrlist, 4, 2, _CHOCO_PARTITION_MAX_BITS + 1, out, offsets);
+    offsets[2] = 10;
+    narrow = _choco_partition(arrlist, 0, 4, 1, narrow, offsets);
+
+    // assert
+    _gt_test_int_eq(_choco_arraylist_length(out), 0);
+    _gt_test_int_eq(_choco_arraylist_length(narrow), 0);
+    _gt_test_int_eq(offsets[0], 0);
+    _gt_test_int_eq(offsets[2], 0);
+    _choco_arraylist_destroy(arrlist);
+    _choco_arraylist_destroy(out);
+    _choco_arraylist_destroy(narrow);
+    _gt_passed();
+}
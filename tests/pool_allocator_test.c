@@ -0,0 +1,68 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/gt/test.h"
+#include "../src/pool_allocator.h"
+#include <stdint.h>
+
+_gt_test(_choco_arraylist_pool_allocator, )
+{
+    // arrange
+    _choco_arraylist_pool pool;
+    _choco_arraylist_pool_init(&pool, _choco_arraylist_heap_allocator(), 100, 4);
+    _choco_arraylist_allocator allocator = _choco_arraylist_pool_allocator(&pool);
+
+    // act
+    void* blocks[10];
+    for (int i = 0; i < 10; i++) {
+        blocks[i] = allocator.allocate(&allocator, 100);
+    }
+    void* too_large = allocator.allocate(&allocator, 129);
+
+    // assert
+    int aligned = 1;
+    for (int i = 0; i < 10; i++) {
+        aligned &= blocks[i] != NULL && (uintptr_t)blocks[i] % 64 == 0;
+    }
+    _gt_test_int_eq(pool.block_size, 128);
+    _gt_test_int_eq(aligned, 1);
+    _gt_test_ptr_eq(too_large, NULL);
+    _gt_test_int_eq(_choco_arraylist_pool_release(&pool), _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_pool_allocator, reuses_blocks)
+{
+    // arrange
+    _choco_arraylist_pool pool;
+    _choco_arraylist_pool_init(&pool, _choco_arraylist_heap_allocator(), 64, 8);
+    _choco_arraylist_allocator allocator = _choco_arraylist_pool_allocator(&pool);
+    void* first = allocator.allocate(&allocator, 64);
+
+    // act
+    allocator.deallocate(&allocator, first);
+    void* second = allocator.allocate(&allocator, 64);
+
+    // assert
+    _gt_test_ptr_eq(second, first);
+    _gt_test_ptr_neq(pool.slabs, NULL);
+    _choco_arraylist_pool_release(&pool);
+    _gt_test_ptr_eq(pool.slabs, NULL);
+    _gt_passed();
+}
+
+_gt_test(_choco_arraylist_pool_init, invalid)
+{
+    // arrange
+    _choco_arraylist_pool pool;
+    _choco_arraylist_allocator invalid = { 0 };
+
+    // act
+    _choco_arraylist_result result = _choco_arraylist_pool_init(&pool, invalid, 64, 8);
+
+    // assert
+    _gt_test_int_eq(result, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _gt_test_int_eq(_choco_arraylist_pool_init(&pool, _choco_arraylist_heap_allocator(), 0, 8), _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _gt_passed();
+}
@@ -0,0 +1,185 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/gt/test.h"
+#include "../src/queue.h"
+#include <pthread.h>
+#include <unistd.h>
+
+#define ITEMS (200000)
+#define PRODUCERS (4)
+#define BATCH (64)
+
+typedef struct producer {
+    _choco_queue* queue;
+    uint64_t id;
+    size_t count;
+} producer;
+
+// Pushes `count` values made of the producer id in the high bits and a counter in the low ones.
+static void* run_producer(void* context)
+{
+    producer* self = context;
+    uint64_t batch[BATCH];
+
+    for (size_t sent = 0; sent < self->count;) {
+        size_t length = self->count - sent < BATCH ? self->count - sent : BATCH;
+        for (size_t i = 0; i < length; i++) {
+            batch[i] = (self->id << 32) | (sent + i);
+        }
+        sent += _choco_queue_push_n(self->queue, batch, length);
+    }
+    return NULL;
+}
+
+// Runs `producers` producers of `count` values each, and returns the number of values popped
+// out of order for their producer.
+static size_t count_misordered(unsigned mode, size_t producers, size_t count)
+{
+    _choco_queue* queue = _choco_queue_create(_choco_arraylist_heap_allocator(), mode, sizeof(uint64_t), 1024);
+    pthread_t threads[PRODUCERS];
+    producer contexts[PRODUCERS];
+    uint64_t expected[PRODUCERS] = { 0 };
+
+    for (size_t i = 0; i < producers; i++) {
+        contexts[i] = (producer) { .queue = queue, .id = i, .count = count };
+        pthread_create(&threads[i], NULL, run_producer, &contexts[i]);
+    }
+
+    size_t misordered = 0;
+    uint64_t batch[BATCH];
+    for (size_t received = 0; received < producers * count;) {
+        size_t popped = _choco_queue_pop_n(queue, batch, BATCH);
+        for (size_t i = 0; i < popped; i++) {
+            uint64_t id = batch[i] >> 32;
+            misordered += id >= producers || (batch[i] & UINT32_MAX) != expected[id]++;
+        }
+        received += popped;
+    }
+
+    for (size_t i = 0; i < producers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    _choco_queue_destroy(queue);
+    return misordered;
+}
+
+static void* push_late(void* context)
+{
+    uint64_t value = 42;
+    usleep(20000);
+    _choco_queue_push_n(context, &value, 1);
+    return NULL;
+}
+
+_gt_test(_choco_queue_create, rounds_capacity)
+{
+    // act
+    _choco_queue* queue = _choco_queue_create(_choco_arraylist_heap_allocator(), _CHOCO_QUEUE_SPSC, sizeof(int), 5);
+
+    // assert
+    _gt_test_ptr_neq(queue, NULL);
+    _gt_test_int_eq(_choco_queue_capacity(queue), 8);
+    _gt_test_int_eq((uintptr_t)queue % _CHOCO_QUEUE_CACHE_LINE, 0);
+    _choco_queue_destroy(queue);
+    _gt_passed();
+}
+
+_gt_test(_choco_queue_try_push_n, wraps)
+{
+    // arrange
+    _choco_queue* queue = _choco_queue_create(_choco_arraylist_heap_allocator(), _CHOCO_QUEUE_SPSC, sizeof(int), 8);
+    int values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    int popped[10] = { 0 };
+
+    // act
+    size_t first = _choco_queue_try_push_n(queue, values, 6);
+    size_t drained = _choco_queue_try_pop_n(queue, popped, 4);
+    size_t second = _choco_queue_try_push_n(queue, values + 6, 4);
+    size_t full = _choco_queue_try_push_n(queue, values, 10);
+    size_t rest = _choco_queue_try_pop_n(queue, popped, 10);
+
+    // assert
+    _gt_test_int_eq(first, 6);
+    _gt_test_int_eq(drained, 4);
+    _gt_test_int_eq(second, 4);
+    _gt_test_int_eq(full, 2);
+    _gt_test_int_eq(rest, 8);
+    _gt_test_int_eq(popped[0], 4);
+    _gt_test_int_eq(popped[5], 9);
+    _gt_test_int_eq(popped[7], 1);
+    _gt_test_int_eq(_choco_queue_length(queue), 0);
+    _choco_queue_destroy(queue);
+    _gt_passed();
+}
+
+_gt_test(_choco_queue_try_pop_n, mpsc_empty)
+{
+    // arrange
+    _choco_queue* queue = _choco_queue_create(_choco_arraylist_heap_allocator(), _CHOCO_QUEUE_MPSC, sizeof(int), 4);
+    int value = 7;
+
+    // act
+    size_t empty = _choco_queue_try_pop_n(queue, &value, 1);
+    _choco_queue_try_push_n(queue, &value, 1);
+    value = 0;
+    size_t popped = _choco_queue_try_pop_n(queue, &value, 4);
+
+    // assert
+    _gt_test_int_eq(empty, 0);
+    _gt_test_int_eq(popped, 1);
+    _gt_test_int_eq(value, 7);
+    _choco_queue_destroy(queue);
+    _gt_passed();
+}
+
+_gt_test(_choco_queue_push_n, spsc_threads)
+{
+    // act
+    size_t misordered = count_misordered(_CHOCO_QUEUE_SPSC, 1, ITEMS);
+
+    // assert
+    _gt_test_int_eq(misordered, 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_queue_push_n, mpsc_threads)
+{
+    // act
+    size_t misordered = count_misordered(_CHOCO_QUEUE_MPSC, PRODUCERS, ITEMS / PRODUCERS);
+
+    // assert
+    _gt_test_int_eq(misordered, 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_queue_push_n, mpsc_blocking_threads)
+{
+    // act
+    size_t misordered = count_misordered(_CHOCO_QUEUE_MPSC | _CHOCO_QUEUE_BLOCKING, PRODUCERS, ITEMS / PRODUCERS);
+
+    // assert
+    _gt_test_int_eq(misordered, 0);
+    _gt_passed();
+}
+
+_gt_test(_choco_queue_pop_n, blocking_wakes)
+{
+    // arrange
+    _choco_queue* queue = _choco_queue_create(_choco_arraylist_heap_allocator(), _CHOCO_QUEUE_SPSC | _CHOCO_QUEUE_BLOCKING, sizeof(uint64_t), 4);
+    pthread_t thread;
+    pthread_create(&thread, NULL, push_late, queue);
+
+    // act
+    uint64_t value = 0;
+    size_t popped = _choco_queue_pop_n(queue, &value, 1);
+
+    // assert
+    pthread_join(thread, NULL);
+    _gt_test_int_eq(popped, 1);
+    _gt_test_int_eq(value, 42);
+    _choco_queue_destroy(queue);
+    _gt_passed();
+}
@@ -0,0 +1,146 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/search_index.h"
+#include "../src/gt/test.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _record {
+    uint32_t id;
+    uint64_t key;
+} _record;
+
+// Keys 0, 3, 6, ... with `id` holding the position.
+static _choco_arraylist init_records(size_t count)
+{
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(_record), count);
+    for (size_t i = 0; i < count; i++) {
+        arrlist = _choco_arraylist_add(arrlist);
+        *(_record*)_choco_arraylist_at(arrlist, i) = (_record) { .id = (uint32_t)i, .key = 3 * i };
+    }
+    return arrlist;
+}
+
+_gt_test(_choco_search_index_build, )
+{
+    // arrange
+    _choco_arraylist arrlist = init_records(1000);
+
+    // act
+    _choco_search_index* index = _choco_search_index_build(arrlist, offsetof(_record, key), sizeof(uint64_t));
+
+    // assert
+    _gt_test_ptr_neq(index, NULL);
+    _gt_test_int_eq(index->length, 1000);
+    _gt_test_int_eq((uintptr_t)index->keys % 64, 0);
+    _gt_test_int_eq(index->keys[1], 3 * 511);
+    _choco_search_index_destroy(index);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_search_index_build, unsorted)
+{
+    // arrange
+    _choco_arraylist arrlist = init_records(10);
+    ((_record*)_choco_arraylist_at(arrlist, 4))->key = 100;
+
+    // act
+    _choco_search_index* index = _choco_search_index_build(arrlist, offsetof(_record, key), sizeof(uint64_t));
+
+    // assert
+    _gt_test_ptr_eq(index, NULL);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_search_index_lookup, )
+{
+    // arrange
+    size_t count = 777;
+    _choco_arraylist arrlist = init_records(count);
+    _choco_search_index* index = _choco_search_index_build(arrlist, offsetof(_record, key), sizeof(uint64_t));
+
+    // act & assert
+    for (size_t i = 0; i < count; i++) {
+        _gt_test_int_eq(_choco_search_index_lookup(index, 3 * i), i);
+        _gt_test_int_eq(_choco_search_index_lookup(index, 3 * i + 1), count);
+        _gt_test_int_eq(_choco_search_index_lower_bound(index, 3 * i + 1), i + 1);
+    }
+    _gt_test_int_eq(_choco_search_index_lower_bound(index, 0), 0);
+    _choco_search_index_destroy(index);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_search_index_lookup, duplicates)
+{
+    // arrange
+    uint16_t keys[] = { 1, 2, 2, 2, 5, 5, 9 };
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint16_t), 7);
+    for (size_t i = 0; i < 7; i++) {
+        arrlist = _choco_arraylist_add(arrlist);
+        *(uint16_t*)_choco_arraylist_at(arrlist, i) = keys[i];
+    }
+    _choco_search_index* index = _choco_search_index_build(arrlist, 0, sizeof(uint16_t));
+
+    // act
+    size_t two = _choco_search_index_lookup(index, 2);
+    size_t five = _choco_search_index_lookup(index, 5);
+    size_t past = _choco_search_index_lower_bound(index, 10);
+
+    // assert
+    _gt_test_int_eq(two, 1);
+    _gt_test_int_eq(five, 4);
+    _gt_test_int_eq(past, 7);
+    _choco_search_index_destroy(index);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_search_index_lookup_n, )
+{
+    // arrange
+    size_t count = 1234;
+    _choco_arraylist arrlist = init_records(count);
+    _choco_search_index* index = _choco_search_index_build(arrlist, offsetof(_record, key), sizeof(uint64_t));
+    uint64_t queries[101];
+    size_t positions[101];
+    for (size_t i = 0; i < 101; i++) {
+        queries[i] = i * 37;
+    }
+
+    // act
+    _choco_search_index_lookup_n(index, queries, 101, positions);
+
+    // assert
+    for (size_t i = 0; i < 101; i++) {
+        _gt_test_int_eq(positions[i], _choco_search_index_lookup(index, queries[i]));
+    }
+    _gt_test_int_eq(positions[3], 37);
+    _gt_test_int_eq(positions[1], count);
+    _choco_search_index_destroy(index);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
+
+_gt_test(_choco_search_index_lookup, empty)
+{
+    // arrange
+    _choco_arraylist arrlist = init_records(0);
+    _choco_search_index* index = _choco_search_index_build(arrlist, offsetof(_record, key), sizeof(uint64_t));
+    uint64_t query = 5;
+    size_t position = 1;
+
+    // act
+    _choco_search_index_lookup_n(index, &query, 1, &position);
+
+    // assert
+    _gt_test_int_eq(_choco_search_index_lookup(index, 5), 0);
+    _gt_test_int_eq(position, 0);
+    _choco_search_index_destroy(index);
+    _choco_arraylist_destroy(arrlist);
+    _gt_passed();
+}
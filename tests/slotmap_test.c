@@ -0,0 +1,114 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/gt/test.h"
+#include "../src/slotmap.h"
+
+static _choco_slotmap* init_map(_choco_slotmap_handle* handles, int count)
+{
+    _choco_slotmap* map = _choco_slotmap_create(_choco_arraylist_heap_allocator(), sizeof(int), 2);
+    for (int i = 0; i < count; i++) {
+        *(int*)_choco_slotmap_insert(map, &handles[i]) = i * 10;
+    }
+    return map;
+}
+
+_gt_test(_choco_slotmap_insert, )
+{
+    // arrange
+    _choco_slotmap_handle handles[100];
+
+    // act
+    _choco_slotmap* map = init_map(handles, 100);
+
+    // assert
+    _gt_test_int_eq(_choco_slotmap_length(map), 100);
+    _gt_test_int_neq(handles[0], _CHOCO_SLOTMAP_NULL);
+    _gt_test_int_eq(*(int*)_choco_slotmap_get(map, handles[0]), 0);
+    _gt_test_int_eq(*(int*)_choco_slotmap_get(map, handles[99]), 990);
+    _choco_slotmap_destroy(map);
+    _gt_passed();
+}
+
+_gt_test(_choco_slotmap_erase, stale_handle)
+{
+    // arrange
+    _choco_slotmap_handle handles[3];
+    _choco_slotmap* map = init_map(handles, 3);
+
+    // act
+    _choco_arraylist_result first = _choco_slotmap_erase(map, handles[1]);
+    _choco_arraylist_result second = _choco_slotmap_erase(map, handles[1]);
+
+    // assert
+    _gt_test_int_eq(first, _CHOCO_ARRAYLIST_RESULT_OK);
+    _gt_test_int_eq(second, _CHOCO_ARRAYLIST_RESULT_ERROR);
+    _gt_test_ptr_eq(_choco_slotmap_get(map, handles[1]), NULL);
+    _gt_test_int_eq(_choco_slotmap_contains(map, handles[1]), _CHOCO_ARRAYLIST_RESULT_NO);
+    _gt_test_int_eq(_choco_slotmap_contains(map, _CHOCO_SLOTMAP_NULL), _CHOCO_ARRAYLIST_RESULT_NO);
+    _choco_slotmap_destroy(map);
+    _gt_passed();
+}
+
+_gt_test(_choco_slotmap_erase, keeps_values_contiguous)
+{
+    // arrange
+    _choco_slotmap_handle handles[5];
+    _choco_slotmap* map = init_map(handles, 5);
+
+    // act
+    _choco_slotmap_erase(map, handles[0]);
+    _choco_slotmap_erase(map, handles[2]);
+
+    // assert
+    _choco_arraylist values = _choco_slotmap_values(map);
+    int sum = 0;
+    for (size_t i = 0; i < _choco_arraylist_length(values); i++) {
+        sum += ((int*)values)[i];
+    }
+    _gt_test_int_eq(_choco_arraylist_length(values), 3);
+    _gt_test_int_eq(sum, 10 + 30 + 40);
+    _gt_test_int_eq(*(int*)_choco_slotmap_get(map, handles[4]), 40);
+    _gt_test_int_eq(*(int*)_choco_slotmap_get(map, handles[3]), 30);
+    _choco_slotmap_destroy(map);
+    _gt_passed();
+}
+
+_gt_test(_choco_slotmap_insert, reuses_slot)
+{
+    // arrange
+    _choco_slotmap_handle handles[3];
+    _choco_slotmap* map = init_map(handles, 3);
+    _choco_slotmap_erase(map, handles[1]);
+
+    // act
+    _choco_slotmap_handle handle;
+    int* value = _choco_slotmap_insert(map, &handle);
+
+    // assert
+    _gt_test_int_eq((uint32_t)handle, (uint32_t)handles[1]);
+    _gt_test_int_neq(handle, handles[1]);
+    _gt_test_int_eq(*value, 0);
+    _gt_test_ptr_eq(_choco_slotmap_get(map, handles[1]), NULL);
+    _gt_test_ptr_eq(_choco_slotmap_get(map, handle), value);
+    _choco_slotmap_destroy(map);
+    _gt_passed();
+}
+
+_gt_test(_choco_slotmap_handle_at, )
+{
+    // arrange
+    _choco_slotmap_handle handles[4];
+    _choco_slotmap* map = init_map(handles, 4);
+    _choco_slotmap_erase(map, handles[0]);
+
+    // act
+    _choco_slotmap_handle moved = _choco_slotmap_handle_at(map, 0);
+
+    // assert
+    _gt_test_int_eq(moved, handles[3]);
+    _gt_test_int_eq(_choco_slotmap_handle_at(map, 3), _CHOCO_SLOTMAP_NULL);
+    _choco_slotmap_destroy(map);
+    _gt_passed();
+}
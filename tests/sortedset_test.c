@@ -0,0 +1,219 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/cpu.h"
+#include "../src/gt/test.h"
+#include "../src/sortedset.h"
+
+// Multiples of `step` from `first`, below `limit`, in a list of u32 or u64.
+static _choco_arraylist init_multiples(size_t size, uint64_t first, uint64_t step, uint64_t limit)
+{
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), size, 16);
+    for (uint64_t value = first; value < limit; value += step) {
+        arrlist = _choco_arraylist_add(arrlist);
+        void* element = _choco_arraylist_at(arrlist, _choco_arraylist_length(arrlist) - 1);
+        if (size == sizeof(uint32_t)) {
+            *(uint32_t*)element = (uint32_t)value;
+        } else {
+            *(uint64_t*)element = value;
+        }
+    }
+    return arrlist;
+}
+
+static uint64_t value_at(_choco_arraylist arrlist, size_t index)
+{
+    void* element = _choco_arraylist_at(arrlist, index);
+    return _choco_arraylist_element_size(arrlist) == sizeof(uint32_t) ? *(uint32_t*)element : *(uint64_t*)element;
+}
+
+// Checks that the list holds, in order, the values below `limit` that `accepts` takes.
+static int holds_exactly(_choco_arraylist arrlist, uint64_t limit, int (*accepts)(uint64_t))
+{
+    size_t index = 0;
+    for (uint64_t value = 0; value < limit; value++) {
+        if (accepts(value)) {
+            if (index >= _choco_arraylist_length(arrlist) || value_at(arrlist, index) != value) {
+                return 0;
+            }
+            index++;
+        }
+    }
+    return index == _choco_arraylist_length(arrlist);
+}
+
+static int is_multiple_of_3_and_5(uint64_t value)
+{
+    return value % 3 == 0 && value % 5 == 0;
+}
+
+static int is_multiple_of_3_or_5(uint64_t value)
+{
+    return value % 3 == 0 || value % 5 == 0;
+}
+
+static int is_multiple_of_3_not_5(uint64_t value)
+{
+    return value % 3 == 0 && value % 5 != 0;
+}
+
+static int is_multiple_of_1000_not_7(uint64_t value)
+{
+    return value % 1000 == 0 && value % 7 != 0;
+}
+
+static int is_multiple_of_7_not_1000(uint64_t value)
+{
+    return value % 7 == 0 && value % 1000 != 0;
+}
+
+static int is_multiple_of_2_3_and_7(uint64_t value)
+{
+    return value % 42 == 0;
+}
+
+_gt_test(_choco_sortedset_intersect_u32, )
+{
+    // arrange
+    _choco_arraylist a = init_multiples(sizeof(uint32_t), 0, 3, 10000);
+    _choco_arraylist b = init_multiples(sizeof(uint32_t), 0, 5, 10000);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint32_t), 4);
+
+    // act
+    dst = _choco_sortedset_intersect_u32(dst, a, b);
+
+    // assert
+    _gt_test_int_eq(holds_exactly(dst, 10000, is_multiple_of_3_and_5), 1);
+    _gt_test_int_eq(_choco_sortedset_intersect_count_u32(b, a), _choco_arraylist_length(dst));
+    _choco_arraylist_destroy(a);
+    _choco_arraylist_destroy(b);
+    _choco_arraylist_destroy(dst);
+    _gt_passed();
+}
+
+_gt_test(_choco_sortedset_intersect_u32, scalar)
+{
+    // arrange
+    _choco_cpu_restrict(0);
+    _choco_arraylist a = init_multiples(sizeof(uint32_t), 0, 3, 10000);
+    _choco_arraylist b = init_multiples(sizeof(uint32_t), 0, 5, 10000);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint32_t), 4);
+
+    // act
+    dst = _choco_sortedset_intersect_u32(dst, a, b);
+
+    // assert
+    _gt_test_int_eq(holds_exactly(dst, 10000, is_multiple_of_3_and_5), 1);
+    _choco_arraylist_destroy(a);
+    _choco_arraylist_destroy(b);
+    _choco_arraylist_destroy(dst);
+    _gt_passed();
+}
+
+_gt_test(_choco_sortedset_union_u32, )
+{
+    // arrange
+    _choco_arraylist a = init_multiples(sizeof(uint32_t), 0, 3, 10000);
+    _choco_arraylist b = init_multiples(sizeof(uint32_t), 0, 5, 10000);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint32_t), 4);
+
+    // act
+    dst = _choco_sortedset_union_u32(dst, a, b);
+
+    // assert
+    _gt_test_int_eq(holds_exactly(dst, 10000, is_multiple_of_3_or_5), 1);
+    _choco_arraylist_destroy(a);
+    _choco_arraylist_destroy(b);
+    _choco_arraylist_destroy(dst);
+    _gt_passed();
+}
+
+_gt_test(_choco_sortedset_difference_u64, )
+{
+    // arrange
+    _choco_arraylist a = init_multiples(sizeof(uint64_t), 0, 3, 10000);
+    _choco_arraylist b = init_multiples(sizeof(uint64_t), 0, 5, 10000);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), 4);
+
+    // act
+    dst = _choco_sortedset_difference_u64(dst, a, b);
+
+    // assert
+    _gt_test_int_eq(holds_exactly(dst, 10000, is_multiple_of_3_not_5), 1);
+    _choco_arraylist_destroy(a);
+    _choco_arraylist_destroy(b);
+    _choco_arraylist_destroy(dst);
+    _gt_passed();
+}
+
+_gt_test(_choco_sortedset_difference_u64, skewed)
+{
+    // arrange
+    _choco_arraylist small = init_multiples(sizeof(uint64_t), 0, 1000, 100000);
+    _choco_arraylist large = init_multiples(sizeof(uint64_t), 0, 7, 100000);
+    _choco_arraylist first = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), 4);
+    _choco_arraylist second = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint64_t), 4);
+
+    // act
+    first = _choco_sortedset_difference_u64(first, small, large);
+    second = _choco_sortedset_difference_u64(second, large, small);
+
+    // assert
+    _gt_test_int_eq(holds_exactly(first, 100000, is_multiple_of_1000_not_7), 1);
+    _gt_test_int_eq(holds_exactly(second, 100000, is_multiple_of_7_not_1000), 1);
+    _gt_test_int_eq(_choco_sortedset_intersect_count_u64(small, large), 15);
+    _gt_test_int_eq(_choco_sortedset_intersect_count_u64(large, small), 15);
+    _choco_arraylist_destroy(small);
+    _choco_arraylist_destroy(large);
+    _choco_arraylist_destroy(first);
+    _choco_arraylist_destroy(second);
+    _gt_passed();
+}
+
+_gt_test(_choco_sortedset_intersect_n_u64, )
+{
+    // arrange
+    _choco_arraylist lists[3] = {
+        init_multiples(sizeof(uint64_t), 0, 2, 100000),
+        init_multiples(sizeof(uint64_t), 0, 7, 100000),
+        init_multiples(sizeof(uint64_t), 0, 3, 100000),
+    };
+    _choco_arraylist dst = init_multiples(sizeof(uint64_t), 0, 1, 0);
+
+    // act
+    dst = _choco_sortedset_intersect_n_u64(dst, lists, 3);
+
+    // assert
+    _gt_test_int_eq(holds_exactly(dst, 100000, is_multiple_of_2_3_and_7), 1);
+    for (int i = 0; i < 3; i++) {
+        _choco_arraylist_destroy(lists[i]);
+    }
+    _choco_arraylist_destroy(dst);
+    _gt_passed();
+}
+
+_gt_test(_choco_sortedset_intersect_u32, reserved)
+{
+    // arrange
+    _choco_arraylist a = init_multiples(sizeof(uint32_t), 0, 3, 1000);
+    _choco_arraylist b = init_multiples(sizeof(uint32_t), 0, 5, 1000);
+    _choco_arraylist wide = init_multiples(sizeof(uint64_t), 0, 5, 1000);
+    _choco_arraylist dst = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(uint32_t), 200);
+    _choco_arraylist reserved = dst;
+
+    // act
+    dst = _choco_sortedset_intersect_u32(dst, a, b);
+    dst = _choco_sortedset_intersect_u32(dst, a, wide);
+
+    // assert
+    _gt_test_ptr_eq(dst, reserved);
+    _gt_test_int_eq(_choco_arraylist_length(dst), 67);
+    _gt_test_ptr_eq(_choco_sortedset_intersect_u32(a, a, b), a);
+    _gt_test_int_eq(_choco_arraylist_length(a), 334);
+    _choco_arraylist_destroy(a);
+    _choco_arraylist_destroy(b);
+    _choco_arraylist_destroy(wide);
+    _choco_arraylist_destroy(dst);
+    _gt_passed();
+}
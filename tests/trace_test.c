@@ -0,0 +1,179 @@
+/*
+    Copyright © 2025 Gaël Fortier <gael.fortier.1@ens.etsmtl.ca>
+*/
+
+#include "../src/arraylist.h"
+#include "../src/mmap_allocator.h"
+#include "../src/pool_allocator.h"
+#include "../src/trace.h"
+#include "../src/gt/test.h"
+#include <pthread.h>
+
+typedef struct _collected {
+    _choco_trace_event events[8];
+    size_t count;
+    size_t first_capacity;
+    uint32_t threads[2];
+    size_t thread_count;
+} _collected;
+
+static void collect(const _choco_trace_event* event, void* context)
+{
+    _collected* collected = context;
+    if (collected->count < 8) {
+        collected->events[collected->count] = *event;
+    }
+    if (collected->count == 0) {
+        collected->first_capacity = event->old_capacity;
+    }
+
+    int known = 0;
+    for (size_t i = 0; i < collected->thread_count; i++) {
+        known |= collected->threads[i] == event->thread;
+    }
+    if (!known && collected->thread_count < 2) {
+        collected->threads[collected->thread_count++] = event->thread;
+    }
+    collected->count++;
+}
+
+static void* record_events(void* arg)
+{
+    for (size_t i = 0; i < 100; i++) {
+        _choco_trace_record(_CHOCO_TRACE_REMOVE, arg, 4, i, i, 1);
+    }
+    return NULL;
+}
+
+_gt_test(_choco_trace_record, )
+{
+    // arrange
+    int list = 0;
+    _collected collected = { 0 };
+
+    // act
+    _choco_trace_record(_CHOCO_TRACE_CREATE, &list, 8, 0, 16, 100);
+    _choco_trace_record(_CHOCO_TRACE_GROW, &list, 8, 16, 34, 200);
+    size_t visited = _choco_trace_dump(collect, &collected);
+
+    // assert
+    _gt_test_int_eq(visited, 2);
+    _gt_test_int_eq(collected.events[0].kind, _CHOCO_TRACE_CREATE);
+    _gt_test_int_eq(collected.events[1].kind, _CHOCO_TRACE_GROW);
+    _gt_test_ptr_eq(collected.events[1].list, &list);
+    _gt_test_int_eq(collected.events[1].size, 8);
+    _gt_test_int_eq(collected.events[1].old_capacity, 16);
+    _gt_test_int_eq(collected.events[1].new_capacity, 34);
+    _gt_test_int_eq(collected.events[1].duration, 200);
+    _gt_test_int_gte(collected.events[1].timestamp, collected.events[0].timestamp);
+    _gt_passed();
+}
+
+_gt_test(_choco_trace_record, wraps_around)
+{
+    // arrange
+    _collected collected = { 0 };
+
+    // act
+    for (size_t i = 0; i < _CHOCO_TRACE_RING_LENGTH + 10; i++) {
+        _choco_trace_record(_CHOCO_TRACE_RESIZE, NULL, 1, i, i + 1, 0);
+    }
+    size_t visited = _choco_trace_dump(collect, &collected);
+
+    // assert
+    _gt_test_int_eq(visited, _CHOCO_TRACE_RING_LENGTH);
+    _gt_test_int_eq(collected.first_capacity, 10);
+    _gt_passed();
+}
+
+_gt_test(_choco_trace_dump, threads)
+{
+    // arrange
+    int list = 0;
+    pthread_t threads[2];
+    _collected collected = { 0 };
+
+    // act
+    for (size_t i = 0; i < 2; i++) {
+        pthread_create(&threads[i], NULL, record_events, &list);
+    }
+    for (size_t i = 0; i < 2; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    size_t visited = _choco_trace_dump(collect, &collected);
+
+    // assert
+    _gt_test_int_eq(visited, 200);
+    _gt_test_int_eq(collected.thread_count, 2);
+    _gt_test_int_neq(collected.threads[0], collected.threads[1]);
+    _gt_passed();
+}
+
+#if defined(CHOCO_TRACE) && !defined(_CHOCO_TRACE_SDT)
+_gt_test(_choco_trace_grow, arraylist)
+{
+    // arrange
+    _collected collected = { 0 };
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_heap_allocator(), sizeof(int), 1);
+
+    // act
+    arrlist = _choco_arraylist_add(arrlist);
+    arrlist = _choco_arraylist_add(arrlist);
+    _choco_arraylist_destroy(arrlist);
+    _choco_trace_dump(collect, &collected);
+
+    // assert
+    _gt_test_int_eq(collected.count, 3);
+    _gt_test_int_eq(collected.events[0].kind, _CHOCO_TRACE_CREATE);
+    _gt_test_int_eq(collected.events[1].kind, _CHOCO_TRACE_GROW);
+    _gt_test_int_eq(collected.events[1].old_capacity, 1);
+    _gt_test_int_eq(collected.events[1].new_capacity, 4);
+    _gt_test_int_eq(collected.events[2].kind, _CHOCO_TRACE_DESTROY);
+    _gt_passed();
+}
+
+_gt_test(_choco_trace_resize, reallocate)
+{
+    // arrange
+    _collected collected = { 0 };
+    _choco_arraylist_mmap_options options = _choco_arraylist_mmap_defaults();
+    options.huge_pages = 0;
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_mmap_allocator(&options), sizeof(int), 10);
+
+    // act
+    arrlist = _choco_arraylist_resize(arrlist, 100000);
+    arrlist = _choco_arraylist_resize(arrlist, 10);
+    _choco_arraylist_destroy(arrlist);
+    _choco_trace_dump(collect, &collected);
+
+    // assert
+    _gt_test_int_eq(collected.count, 4);
+    _gt_test_int_eq(collected.events[1].kind, _CHOCO_TRACE_RESIZE);
+    _gt_test_int_eq(collected.events[1].old_capacity, 10);
+    _gt_test_int_eq(collected.events[1].new_capacity, 100000);
+    _gt_test_int_eq(collected.events[2].kind, _CHOCO_TRACE_RESIZE);
+    _gt_test_int_eq(collected.events[2].old_capacity, 100000);
+    _gt_test_int_eq(collected.events[2].new_capacity, 10);
+    _gt_passed();
+}
+_gt_test(_choco_trace_grow, failed)
+{
+    // arrange
+    _collected collected = { 0 };
+    _choco_arraylist_pool pool;
+    _choco_arraylist_pool_init(&pool, _choco_arraylist_heap_allocator(), sizeof(_choco_arraylist_header) + 12 * sizeof(int), 1);
+    _choco_arraylist arrlist = _choco_arraylist_create(_choco_arraylist_pool_allocator(&pool), sizeof(int), 12);
+    arrlist = _choco_arraylist_add_n(arrlist, 12);
+
+    // act
+    arrlist = _choco_arraylist_add(arrlist);
+    arrlist = _choco_arraylist_add_n(arrlist, 4);
+    _choco_trace_dump(collect, &collected);
+
+    // assert
+    _gt_test_int_eq(collected.count, 1);
+    _gt_test_int_eq(collected.events[0].kind, _CHOCO_TRACE_CREATE);
+    _choco_arraylist_pool_release(&pool);
+    _gt_passed();
+}
+#endif